@@ -0,0 +1,51 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Small utilities shared by the benchmark programs in this directory: a
+ * monotonic clock and a fast, seedable pseudo-random number generator
+ * (xorshift64*), so that runs are reproducible across machines.
+ * Everything is inline, so that each benchmark is a single source file to be
+ * compiled together with the sources of the libraries it measures, e.g.:
+ *  gcc -O2 -pthread sssp_bench.c <library sources> -o sssp_bench
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef BENCHUTILS_H
+#define BENCHUTILS_H
+
+#include <stdint.h>
+#include <time.h>
+
+/* Pseudo-random number generator state. Must not be zero. */
+typedef struct {
+    uint64_t state;
+} BenchRNG;
+
+/* Returns the current time of the monotonic clock, in nanoseconds. */
+static inline uint64_t benchNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* Seeds a generator. */
+static inline void benchSeed(BenchRNG *rng, uint64_t seed) {
+    rng->state = seed != 0 ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+/* Returns the next 64 pseudo-random bits. */
+static inline uint64_t benchRandom(BenchRNG *rng) {
+    rng->state ^= rng->state >> 12;
+    rng->state ^= rng->state << 25;
+    rng->state ^= rng->state >> 27;
+    return rng->state * 0x2545F4914F6CDD1DULL;
+}
+
+/* Returns a pseudo-random integer in [0, bound). */
+static inline uint64_t benchRandomBelow(BenchRNG *rng, uint64_t bound) {
+    return bound > 0 ? benchRandom(rng) % bound : 0;
+}
+
+#endif
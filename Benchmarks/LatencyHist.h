@@ -0,0 +1,101 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Latency histogram for the benchmark programs in this directory, in the
+ * style of HdrHistogram: values (e.g. nanoseconds) are counted in buckets
+ * for each power of two, each split in LAT_SUB_COUNT linear sub-buckets, so
+ * that any 64-bit value is recorded in constant time and space with a
+ * relative error below 1%, and percentiles can be read down to the tail.
+ * Like BenchUtils.h, everything is inline.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef LATENCYHIST_H
+#define LATENCYHIST_H
+
+#include <stdint.h>
+#include <string.h>
+
+/* Linear sub-buckets for each power of two. Values below LAT_SUB_COUNT are
+ * recorded exactly; the others with an error below 1 / LAT_SUB_COUNT.
+ */
+#define LAT_SUB_BITS 7
+#define LAT_SUB_COUNT (1 << LAT_SUB_BITS)
+#define LAT_BUCKETS (64 - LAT_SUB_BITS + 1)
+
+/* Latency histogram. */
+typedef struct {
+    uint64_t counts[LAT_BUCKETS * LAT_SUB_COUNT];
+    uint64_t total;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} LatHist;
+
+/* Empties a histogram. */
+static inline void latReset(LatHist *hist) {
+    memset(hist, 0, sizeof(LatHist));
+    hist->min = UINT64_MAX;
+}
+
+/* Returns the index of the counter of a value. */
+static inline unsigned latIndex(uint64_t value) {
+    if (value < LAT_SUB_COUNT) return (unsigned)value;
+    unsigned shift = 63 - (unsigned)__builtin_clzll(value) - LAT_SUB_BITS;
+    return ((shift + 1) * LAT_SUB_COUNT) +
+           (unsigned)((value >> shift) - LAT_SUB_COUNT);
+}
+
+/* Returns the greatest value counted by a counter. */
+static inline uint64_t latHighest(unsigned idx) {
+    unsigned bucket = idx / LAT_SUB_COUNT, sub = idx % LAT_SUB_COUNT;
+    if (bucket == 0) return sub;
+    return ((((uint64_t)LAT_SUB_COUNT + sub + 1) << (bucket - 1)) - 1);
+}
+
+/* Records a value. */
+static inline void latRecord(LatHist *hist, uint64_t value) {
+    hist->counts[latIndex(value)]++;
+    hist->total++;
+    hist->sum += value;
+    if (value < hist->min) hist->min = value;
+    if (value > hist->max) hist->max = value;
+}
+
+/* Adds the counts of a histogram to another one. */
+static inline void latMerge(LatHist *dst, const LatHist *src) {
+    for (unsigned i = 0; i < (LAT_BUCKETS * LAT_SUB_COUNT); i++)
+        dst->counts[i] += src->counts[i];
+    dst->total += src->total;
+    dst->sum += src->sum;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+}
+
+/* Returns the mean of the values (0 if empty). */
+static inline double latMean(const LatHist *hist) {
+    return hist->total > 0 ? (double)hist->sum / (double)hist->total : 0.0;
+}
+
+/* Returns the value at a percentile (in [0, 100]), i.e. the greatest value
+ * equivalent to it within the precision of the histogram (0 if empty).
+ */
+static inline uint64_t latPercentile(const LatHist *hist, double pct) {
+    if (hist->total == 0) return 0;
+    uint64_t rank = (uint64_t)((pct / 100.0) * (double)hist->total + 0.5);
+    if (rank == 0) rank = 1;
+    if (rank >= hist->total) return hist->max;
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < (LAT_BUCKETS * LAT_SUB_COUNT); i++) {
+        seen += hist->counts[i];
+        if (seen >= rank) {
+            uint64_t value = latHighest(i);
+            return value < hist->max ? value : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+#endif
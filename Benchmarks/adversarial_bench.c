@@ -0,0 +1,234 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Adversarial benchmark of the Fibonacci Heap: each scenario drives the heap
+ * into one of its expensive paths on purpose, and reports the latency of
+ * single operations (mean, percentiles and maximum, see LatencyHist.h), since
+ * what matters here is the worst case, which averages hide. Scenarios:
+ * - cascade: a chain of k nodes, each the only son of its father and marked
+ *   as having lost another one, is grown one node at a time; then the key of
+ *   its bottom node is decreased, so that cascading cuts climb the whole
+ *   chain, and the next minimum deletion consolidates the k new roots;
+ * - root-list: n insertions leave n roots, which the first minimum deletion
+ *   links all at once;
+ * - increase-root: the minimum key is increased over and over, so that each
+ *   time the minimum is deleted, its sons are planted and linked again;
+ * - zero-keys: deletions of nodes from a heap where all keys are 0, which
+ *   is the key that deletions force on their target;
+ * - tiny-forest: as root-list, but with an initial maximum tree order of 1,
+ *   so that the forest is grown during the consolidation.
+ * Usage: adversarial_bench [n] [chain length] [repetitions]
+ * (default: n = 2^20, chains of 2^14 nodes, 8 repetitions of single-shot
+ * scenarios).
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "BenchUtils.h"
+#include "LatencyHist.h"
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Exits on allocation failures. */
+void *check(void *ptr) {
+    if (ptr == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+/* Prints a row of results. */
+void report(const char *scenario, const char *op, const char *param,
+            LatHist *hist) {
+    printf("%-14s %-14s %-16s %9lu %10.2f %10.2f %10.2f %10.2f %11.2f\n",
+           scenario, op, param, hist->total, latMean(hist) / 1e3,
+           (double)latPercentile(hist, 50.0) / 1e3,
+           (double)latPercentile(hist, 99.0) / 1e3,
+           (double)latPercentile(hist, 99.9) / 1e3,
+           (double)hist->max / 1e3);
+}
+
+/* Builds a heap holding a single tree, whose root has a leaf son and a chain
+ * of length nodes below its other son, each with a single son and marked,
+ * apart from the bottom one. Each step puts a new root above the old one,
+ * then makes the old one lose its leaf.
+ * Returns the bottom node of the chain.
+ */
+FibTreeNode *buildChain(FibHeap *heap, ulong length) {
+    uint64_t key = UINT64_MAX - 8;
+    FibTreeNode *root = NULL, *bottom = NULL;
+    for (ulong i = 0; i < length; i++) {
+        // Five new smallest keys: the first one is deleted right away, and
+        // the consolidation puts the second one on top of everything.
+        for (ulong j = 0; j < 5; j++)
+            check(fhInsert(heap, NULL, key - 5 + j));
+        key -= 5;
+        eraseFibTreeNode(fhDeleteMin(heap), 0);
+        FibTreeNode *newRoot = heap->min, *single = NULL, *leaf = NULL;
+        for (FibTreeNode *son = newRoot->_firstSon; son != NULL;
+             son = son->_nextBro)
+            if ((son != root) && (son->_sonsCnt == 1)) single = son;
+        if ((single == NULL) || ((root != NULL) && (root->_father != newRoot)))
+            return NULL;  // Unexpected shape.
+        if (root == NULL) {
+            // First step: the son of the B1 tree is deleted, so that its
+            // root becomes a marked node with no sons, i.e. the bottom.
+            bottom = single;
+            eraseFibTreeNode(fhDelete(heap, single->_firstSon), 0);
+        } else {
+            // Drop the B1 tree, then make the old root lose its leaf.
+            FibTreeNode *orphan = single->_firstSon;
+            eraseFibTreeNode(fhDelete(heap, single), 0);
+            for (FibTreeNode *son = root->_firstSon; son != NULL;
+                 son = son->_nextBro)
+                if (son->_sonsCnt == 0) leaf = son;
+            if ((root->_sonsCnt == 2) && (leaf != NULL))
+                eraseFibTreeNode(fhDelete(heap, leaf), 0);
+            eraseFibTreeNode(fhDelete(heap, orphan), 0);
+        }
+        root = newRoot;
+    }
+    return bottom;
+}
+
+/* Cascading cuts along a chain, and the consolidation that follows. */
+void cascade(ulong length, ulong reps) {
+    LatHist *decHist = check(malloc(sizeof(LatHist)));
+    LatHist *delHist = check(malloc(sizeof(LatHist)));
+    latReset(decHist);
+    latReset(delHist);
+    ulong depth = 0;
+    for (ulong r = 0; r < reps; r++) {
+        FibHeap *heap = check(createFibHeap(16));
+        FibTreeNode *bottom = buildChain(heap, length);
+        if (bottom == NULL) {
+            fprintf(stderr, "Failed to build the chain.\n");
+            exit(EXIT_FAILURE);
+        }
+        depth = 0;
+        for (FibTreeNode *curr = bottom; curr->_father != NULL;
+             curr = curr->_father)
+            depth++;
+        uint64_t start = benchNow();
+        fhDecreaseKey(heap, bottom, bottom->key);
+        latRecord(decHist, benchNow() - start);
+        start = benchNow();
+        eraseFibTreeNode(fhDeleteMin(heap), 0);
+        latRecord(delHist, benchNow() - start);
+        eraseFibHeap(heap, 0);
+    }
+    char param[32];
+    snprintf(param, sizeof(param), "depth %lu", depth);
+    report("cascade", "decrease-key", param, decHist);
+    report("cascade", "delete-min", param, delHist);
+    free(decHist);
+    free(delHist);
+}
+
+/* A consolidation of n roots, with a given initial maximum tree order. */
+void rootList(const char *scenario, ulong n, ulong initTreeOrd, ulong reps) {
+    LatHist *insHist = check(malloc(sizeof(LatHist)));
+    LatHist *delHist = check(malloc(sizeof(LatHist)));
+    latReset(insHist);
+    latReset(delHist);
+    BenchRNG rng;
+    benchSeed(&rng, 42);
+    for (ulong r = 0; r < reps; r++) {
+        FibHeap *heap = check(createFibHeap(initTreeOrd));
+        for (ulong i = 0; i < n; i++) {
+            uint64_t start = benchNow();
+            check(fhInsert(heap, NULL, benchRandom(&rng)));
+            latRecord(insHist, benchNow() - start);
+        }
+        uint64_t start = benchNow();
+        eraseFibTreeNode(fhDeleteMin(heap), 0);
+        latRecord(delHist, benchNow() - start);
+        eraseFibHeap(heap, 0);
+    }
+    char param[32];
+    snprintf(param, sizeof(param), "roots %lu", n);
+    report(scenario, "insert", param, insHist);
+    report(scenario, "delete-min", param, delHist);
+    free(insHist);
+    free(delHist);
+}
+
+/* Repeated increases of the minimum key. */
+void increaseRoot(ulong n) {
+    LatHist *hist = check(malloc(sizeof(LatHist)));
+    latReset(hist);
+    BenchRNG rng;
+    benchSeed(&rng, 42);
+    FibHeap *heap = check(createFibHeap(16));
+    for (ulong i = 0; i < n; i++)
+        check(fhInsert(heap, NULL, benchRandomBelow(&rng, n)));
+    eraseFibTreeNode(fhDeleteMin(heap), 0);
+    for (ulong i = 0; i < n; i++) {
+        uint64_t start = benchNow();
+        fhIncreaseKey(heap, heap->min, n + benchRandomBelow(&rng, n));
+        latRecord(hist, benchNow() - start);
+    }
+    eraseFibHeap(heap, 0);
+    char param[32];
+    snprintf(param, sizeof(param), "nodes %lu", n);
+    report("increase-root", "increase-key", param, hist);
+    free(hist);
+}
+
+/* Deletions of random nodes, all with key 0. */
+void zeroKeys(ulong n) {
+    LatHist *hist = check(malloc(sizeof(LatHist)));
+    latReset(hist);
+    BenchRNG rng;
+    benchSeed(&rng, 42);
+    FibHeap *heap = check(createFibHeap(16));
+    FibTreeNode **nodes = check(calloc(n, sizeof(FibTreeNode *)));
+    for (ulong i = 0; i < n; i++) nodes[i] = check(fhInsert(heap, NULL, 0));
+    eraseFibTreeNode(fhDelete(heap, nodes[n - 1]), 0);
+    for (ulong i = n - 1; i > 0; i--) {
+        // Pick a random node still in the heap, and swap it out.
+        ulong pos = benchRandomBelow(&rng, i);
+        FibTreeNode *node = nodes[pos];
+        nodes[pos] = nodes[i - 1];
+        uint64_t start = benchNow();
+        FibTreeNode *deleted = fhDelete(heap, node);
+        latRecord(hist, benchNow() - start);
+        if (deleted != node) {
+            fprintf(stderr, "Deleted the wrong node.\n");
+            exit(EXIT_FAILURE);
+        }
+        eraseFibTreeNode(deleted, 0);
+    }
+    free(nodes);
+    eraseFibHeap(heap, 0);
+    char param[32];
+    snprintf(param, sizeof(param), "nodes %lu", n);
+    report("zero-keys", "delete", param, hist);
+    free(hist);
+}
+
+int main(int argc, char **argv) {
+    ulong n = argc > 1 ? strtoul(argv[1], NULL, 10) : (1UL << 20);
+    ulong length = argc > 2 ? strtoul(argv[2], NULL, 10) : (1UL << 14);
+    ulong reps = argc > 3 ? strtoul(argv[3], NULL, 10) : 8;
+    if ((n < 2) || (length == 0) || (reps == 0)) {
+        fprintf(stderr, "Usage: %s [n] [chain length] [repetitions]\n",
+                argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Latencies in us.\n");
+    printf("%-14s %-14s %-16s %9s %10s %10s %10s %10s %11s\n", "scenario",
+           "operation", "parameter", "count", "mean", "p50", "p99", "p99.9",
+           "max");
+    cascade(length, reps);
+    rootList("root-list", n, 20, reps);
+    increaseRoot(n);
+    zeroKeys(n);
+    rootList("tiny-forest", n, 1, reps);
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,214 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Open-loop latency benchmark of the priority queues in this repository.
+ * Operations are issued on a fixed-rate schedule, and the latency of each one
+ * is measured from the time it was meant to start, not from the time it
+ * actually started: if an operation stalls (e.g. a long consolidation of the
+ * Fibonacci Heap), the ones scheduled meanwhile are delayed and their latency
+ * accounts for it, as it would for requests arriving at a server. Closed-loop
+ * benchmarks, which just issue the next operation when the previous one is
+ * done, hide such stalls ("coordinated omission").
+ * Each queue is first filled with n random keys; then each scheduled
+ * operation is either an insertion or a minimum deletion, with the same
+ * probability, and inserted keys are the last deleted one plus a random
+ * increment in [0, 2 * MEAN_STEP), as in the hold model. Runs last a given
+ * time, at offered loads that double from a starting rate until the queue
+ * can't keep up (its achieved rate falls below 95% of the offered one), which
+ * is its saturation point.
+ * Latency percentiles are read from HDR histograms (see LatencyHist.h).
+ * Usage: openloop_bench [heap size] [seconds per run] [starting rate]
+ * (default: 2^20 keys, 1 second, 250000 operations per second).
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "BenchUtils.h"
+#include "LatencyHist.h"
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+#include "../SequenceHeap_uint64-keys/SequenceHeap_uint64-keys.h"
+#include "../VanEmdeBoas_uint64-keys/VanEmdeBoas_uint64-keys.h"
+
+#define MEAN_STEP 1000
+#define MAX_RATE 1000000000UL
+
+/* Priority queue under test, behind a common interface. */
+typedef struct {
+    const char *name;
+    void *(*create)(ulong size);
+    int (*insert)(void *queue, uint64_t key);       // 0 on success.
+    int (*deleteMin)(void *queue, uint64_t *key);   // -1 if empty.
+    void (*erase)(void *queue);
+} Engine;
+
+void *fibCreate(ulong size) {
+    ulong treeOrd = 1;
+    while ((1UL << treeOrd) < size) treeOrd++;
+    return createFibHeap(treeOrd);
+}
+
+void *fibPooledCreate(ulong size) {
+    ulong treeOrd = 1;
+    while ((1UL << treeOrd) < size) treeOrd++;
+    return createPooledFibHeap(treeOrd);
+}
+
+void *fibRelaxedCreate(ulong size) {
+    FibHeap *heap = fibCreate(size);
+    if ((heap != NULL) && (fhSetRelaxed(heap, 256, 0) != 0)) {
+        eraseFibHeap(heap, 0);
+        return NULL;
+    }
+    return heap;
+}
+
+int fibInsert(void *queue, uint64_t key) {
+    return fhInsert(queue, NULL, key) != NULL ? 0 : -1;
+}
+
+int fibDeleteMin(void *queue, uint64_t *key) {
+    FibTreeNode *minNode = fhDeleteMin(queue);
+    if (minNode == NULL) return -1;
+    *key = minNode->key;
+    eraseFibTreeNode(minNode, 0);
+    return 0;
+}
+
+void fibErase(void *queue) {
+    eraseFibHeap(queue, 0);
+}
+
+void *seqCreate(ulong size) {
+    (void)size;
+    return createSeqHeap(0, 0);
+}
+
+int seqInsert(void *queue, uint64_t key) {
+    return sqInsert(queue, NULL, key);
+}
+
+int seqDeleteMin(void *queue, uint64_t *key) {
+    void *elem;
+    return sqDeleteMin(queue, &elem, key);
+}
+
+void seqErase(void *queue) {
+    eraseSeqHeap(queue, 0);
+}
+
+void *vebCreate(ulong size) {
+    (void)size;
+    return createVEBHeap(48);
+}
+
+int vebInsertKey(void *queue, uint64_t key) {
+    return vebInsert(queue, NULL, key) != NULL ? 0 : -1;
+}
+
+int vebDeleteMinKey(void *queue, uint64_t *key) {
+    VEBItem *item = vebDeleteMin(queue);
+    if (item == NULL) return -1;
+    *key = item->key;
+    eraseVEBItem(item, 0);
+    return 0;
+}
+
+void vebErase(void *queue) {
+    eraseVEBHeap(queue, 0);
+}
+
+static const Engine engines[] = {
+    {"fib", fibCreate, fibInsert, fibDeleteMin, fibErase},
+    {"fib-pooled", fibPooledCreate, fibInsert, fibDeleteMin, fibErase},
+    {"fib-relaxed", fibRelaxedCreate, fibInsert, fibDeleteMin, fibErase},
+    {"sequence", seqCreate, seqInsert, seqDeleteMin, seqErase},
+    {"veb", vebCreate, vebInsertKey, vebDeleteMinKey, vebErase},
+};
+
+/* Runs a queue at a fixed rate for ops operations, recording latencies.
+ * Returns the achieved rate, in operations per second.
+ */
+double run(const Engine *engine, ulong size, ulong rate, ulong ops,
+           LatHist *hist) {
+    BenchRNG rng;
+    benchSeed(&rng, 42);
+    void *queue = engine->create(size);
+    if (queue == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (ulong i = 0; i < size; i++) {
+        if (engine->insert(queue, benchRandomBelow(&rng, size * MEAN_STEP))) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    // The first deletion consolidates the whole heap: not part of the load.
+    uint64_t lastKey = 0;
+    engine->deleteMin(queue, &lastKey);
+
+    latReset(hist);
+    uint64_t start = benchNow(), end = start;
+    for (ulong i = 0; i < ops; i++) {
+        uint64_t intended = start + ((i * 1000000000UL) / rate);
+        while ((end = benchNow()) < intended);
+        int ret = -1;
+        if (benchRandom(&rng) & 1) ret = engine->deleteMin(queue, &lastKey);
+        if (ret != 0)
+            ret = engine->insert(queue, lastKey +
+                                 benchRandomBelow(&rng, 2 * MEAN_STEP));
+        if (ret != 0) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+        end = benchNow();
+        latRecord(hist, end - intended);
+    }
+    engine->erase(queue);
+    return (double)ops / ((double)(end - start) / 1e9);
+}
+
+int main(int argc, char **argv) {
+    ulong size = argc > 1 ? strtoul(argv[1], NULL, 10) : (1UL << 20);
+    double seconds = argc > 2 ? strtod(argv[2], NULL) : 1.0;
+    ulong startRate = argc > 3 ? strtoul(argv[3], NULL, 10) : 250000;
+    if ((size == 0) || (seconds <= 0.0) || (startRate == 0) ||
+        (startRate > MAX_RATE)) {
+        fprintf(stderr, "Usage: %s [heap size] [seconds per run] "
+                "[starting rate]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    LatHist *hist = malloc(sizeof(LatHist));
+    if (hist == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Open loop: %lu keys, %.1f s per run, latencies in us.\n", size,
+           seconds);
+    printf("%-12s %9s %9s %9s %9s %9s %9s %9s %10s\n", "queue", "offered",
+           "achieved", "p50", "p90", "p99", "p99.9", "p99.99", "max");
+    for (ulong e = 0; e < sizeof(engines) / sizeof(Engine); e++) {
+        for (ulong rate = startRate; rate <= MAX_RATE; rate *= 2) {
+            ulong ops = (ulong)((double)rate * seconds);
+            if (ops == 0) ops = 1;
+            double achieved = run(&(engines[e]), size, rate, ops, hist);
+            int saturated = achieved < (0.95 * (double)rate);
+            printf("%-12s %8.3fM %8.3fM %9.2f %9.2f %9.2f %9.2f %9.2f "
+                   "%10.2f%s\n", engines[e].name, (double)rate / 1e6,
+                   achieved / 1e6, (double)latPercentile(hist, 50.0) / 1e3,
+                   (double)latPercentile(hist, 90.0) / 1e3,
+                   (double)latPercentile(hist, 99.0) / 1e3,
+                   (double)latPercentile(hist, 99.9) / 1e3,
+                   (double)latPercentile(hist, 99.99) / 1e3,
+                   (double)hist->max / 1e3, saturated ? "  saturated" : "");
+            if (saturated) break;
+        }
+    }
+    free(hist);
+    exit(EXIT_SUCCESS);
+}
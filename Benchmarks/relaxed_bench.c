@@ -0,0 +1,121 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Benchmark of the relaxed mode of the Fibonacci Heap, which trades accuracy
+ * of the minimum for speed. Uses the "hold" model: after the heap is filled,
+ * each operation deletes the minimum and inserts a new key, which is the
+ * deleted one plus a random increment in [0, 2 * MEAN_STEP).
+ * Each configuration (bound on roots, admitted key error) is run twice:
+ * - once alone, to measure throughput;
+ * - once with an exact heap holding the same keys, to measure the actual
+ *   error of each deletion against the true minimum.
+ * Usage: relaxed_bench [heap size] [operations]
+ * (default: 2^20 nodes, 2^22 operations).
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "BenchUtils.h"
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+#define MEAN_STEP 1000
+
+/* Relaxed mode configuration. */
+typedef struct {
+    ulong maxRoots;
+    uint64_t eps;
+} Config;
+
+/* Configurations to run; the first one is the exact heap. */
+static const Config configs[] = {
+    {0, 0},
+    {64, 0},
+    {256, 0},
+    {64, MEAN_STEP / 10},
+    {256, MEAN_STEP},
+    {1024, MEAN_STEP},
+    {1024, 10 * MEAN_STEP},
+    {4096, 100 * MEAN_STEP},
+};
+
+/* Runs the hold model on a heap, returning the elapsed time in seconds.
+ * If a shadow exact heap is given, each element of the heap is its own node
+ * in the shadow one, and the key error of each deletion is accumulated.
+ */
+double hold(FibHeap *heap, FibHeap *shadow, ulong size, ulong ops,
+            uint64_t *errSum, uint64_t *errMax) {
+    BenchRNG rng;
+    benchSeed(&rng, 42);
+    *errSum = 0;
+    *errMax = 0;
+    for (ulong i = 0; i < size; i++) {
+        uint64_t key = benchRandomBelow(&rng, size * MEAN_STEP);
+        FibTreeNode *twin = NULL;
+        if (shadow != NULL) twin = fhInsert(shadow, NULL, key);
+        if (fhInsert(heap, twin, key) == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    uint64_t start = benchNow();
+    for (ulong i = 0; i < ops; i++) {
+        FibTreeNode *minNode = fhDeleteMin(heap);
+        uint64_t key = minNode->key;
+        if (shadow != NULL) {
+            uint64_t err = key - shadow->min->key;
+            *errSum += err;
+            if (err > *errMax) *errMax = err;
+            eraseFibTreeNode(fhDelete(shadow, minNode->elem), 0);
+        }
+        eraseFibTreeNode(minNode, 0);
+        key += benchRandomBelow(&rng, 2 * MEAN_STEP);
+        FibTreeNode *twin = NULL;
+        if (shadow != NULL) twin = fhInsert(shadow, NULL, key);
+        if (fhInsert(heap, twin, key) == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return (double)(benchNow() - start) / 1e9;
+}
+
+int main(int argc, char **argv) {
+    ulong size = argc > 1 ? strtoul(argv[1], NULL, 10) : (1UL << 20);
+    ulong ops = argc > 2 ? strtoul(argv[2], NULL, 10) : (1UL << 22);
+    if ((size == 0) || (ops == 0)) {
+        fprintf(stderr, "Usage: %s [heap size] [operations]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    ulong treeOrd = 1;
+    while ((1UL << treeOrd) < size) treeOrd++;
+
+    printf("Hold model: %lu nodes, %lu operations, mean step %d.\n", size,
+           ops, MEAN_STEP);
+    printf("%10s %10s %12s %10s %12s %12s\n", "max roots", "eps", "Mops/s",
+           "speedup", "mean error", "max error");
+    double exactTime = 0.0;
+    for (ulong c = 0; c < sizeof(configs) / sizeof(Config); c++) {
+        uint64_t errSum, errMax;
+        FibHeap *heap = createFibHeap(treeOrd);
+        fhSetRelaxed(heap, configs[c].maxRoots, configs[c].eps);
+        double time = hold(heap, NULL, size, ops, &errSum, &errMax);
+        eraseFibHeap(heap, 0);
+        if (c == 0) exactTime = time;
+
+        heap = createFibHeap(treeOrd);
+        FibHeap *shadow = createFibHeap(treeOrd);
+        fhSetRelaxed(heap, configs[c].maxRoots, configs[c].eps);
+        hold(heap, shadow, size, ops, &errSum, &errMax);
+        eraseFibHeap(heap, 0);
+        eraseFibHeap(shadow, 0);
+
+        printf("%10lu %10lu %12.3f %9.2fx %12.2f %12lu\n",
+               configs[c].maxRoots, configs[c].eps, (double)ops / time / 1e6,
+               exactTime / time, (double)errSum / (double)ops, errMax);
+    }
+    exit(EXIT_SUCCESS);
+}
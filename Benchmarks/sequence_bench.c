@@ -0,0 +1,118 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Benchmark of the Sequence Heap against the Fibonacci Heap on very large
+ * queues. Each run inserts n random keys and then deletes them all, checking
+ * that they come out in order; the Fibonacci Heap is run only up to a given
+ * size, since its nodes take several times the memory of a sequence heap
+ * entry. Sizes go from 2^20 up to n, by factors of 8.
+ * The sequence heap takes about 16 bytes per element, plus as much again for
+ * the largest merge of runs: 10^9 elements need about 32 GB of memory.
+ * Usage: sequence_bench [n] [max Fibonacci Heap size]
+ * (default: n = 10^9, Fibonacci Heap up to 2^24 nodes).
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "BenchUtils.h"
+#include "../SequenceHeap_uint64-keys/SequenceHeap_uint64-keys.h"
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Runs the sequence heap on n keys. Returns 0 on success, -1 on failure. */
+int runSeqHeap(ulong n, double *insTime, double *delTime) {
+    BenchRNG rng;
+    benchSeed(&rng, n);
+    SeqHeap *heap = createSeqHeap(0, 0);
+    if (heap == NULL) return -1;
+    uint64_t start = benchNow();
+    for (ulong i = 0; i < n; i++) {
+        if (sqInsert(heap, NULL, benchRandom(&rng)) != 0) {
+            eraseSeqHeap(heap, 0);
+            return -1;
+        }
+    }
+    *insTime = (double)(benchNow() - start) / 1e9;
+    start = benchNow();
+    uint64_t key, last = 0;
+    for (ulong i = 0; i < n; i++) {
+        if ((sqDeleteMin(heap, NULL, &key) != 0) || (key < last)) {
+            eraseSeqHeap(heap, 0);
+            return -1;
+        }
+        last = key;
+    }
+    *delTime = (double)(benchNow() - start) / 1e9;
+    eraseSeqHeap(heap, 0);
+    return 0;
+}
+
+/* Runs the Fibonacci Heap on n keys. Returns 0 on success, -1 on failure. */
+int runFibHeap(ulong n, double *insTime, double *delTime) {
+    BenchRNG rng;
+    benchSeed(&rng, n);
+    FibHeap *heap = createPooledFibHeap(64);
+    if (heap == NULL) return -1;
+    uint64_t start = benchNow();
+    for (ulong i = 0; i < n; i++) {
+        if (fhInsert(heap, NULL, benchRandom(&rng)) == NULL) {
+            eraseFibHeap(heap, 0);
+            return -1;
+        }
+    }
+    *insTime = (double)(benchNow() - start) / 1e9;
+    start = benchNow();
+    uint64_t last = 0;
+    for (ulong i = 0; i < n; i++) {
+        FibTreeNode *minNode = fhDeleteMin(heap);
+        if ((minNode == NULL) || (minNode->key < last)) {
+            eraseFibHeap(heap, 0);
+            return -1;
+        }
+        last = minNode->key;
+        eraseFibTreeNode(minNode, 0);
+    }
+    *delTime = (double)(benchNow() - start) / 1e9;
+    eraseFibHeap(heap, 0);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    ulong n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000000UL;
+    ulong fibMax = argc > 2 ? strtoul(argv[2], NULL, 10) : (1UL << 24);
+    if (n == 0) {
+        fprintf(stderr, "Usage: %s [n] [max Fibonacci Heap size]\n",
+                argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%12s %16s %12s %12s\n", "elements", "heap", "insert ns",
+           "delete ns");
+    ulong size = n < (1UL << 20) ? n : (1UL << 20);
+    while (1) {
+        double insTime, delTime;
+        if (runSeqHeap(size, &insTime, &delTime) != 0) {
+            fprintf(stderr, "Sequence Heap failed at %lu elements.\n", size);
+            exit(EXIT_FAILURE);
+        }
+        printf("%12lu %16s %12.1f %12.1f\n", size, "sequence",
+               insTime * 1e9 / (double)size, delTime * 1e9 / (double)size);
+        if (size <= fibMax) {
+            if (runFibHeap(size, &insTime, &delTime) != 0) {
+                fprintf(stderr, "Fibonacci Heap failed at %lu elements.\n",
+                        size);
+                exit(EXIT_FAILURE);
+            }
+            printf("%12lu %16s %12.1f %12.1f\n", size, "fibonacci",
+                   insTime * 1e9 / (double)size,
+                   delTime * 1e9 / (double)size);
+        }
+        fflush(stdout);
+        if (size == n) break;
+        size = (size * 8 < n) ? size * 8 : n;
+    }
+    exit(EXIT_SUCCESS);
+}
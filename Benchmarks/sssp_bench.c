@@ -0,0 +1,188 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Benchmark of single-source shortest paths: sequential Dijkstra on a
+ * Fibonacci Heap against parallel Delta Stepping, with increasing numbers of
+ * threads, on two kinds of synthetic graphs:
+ * - road-like: a 2D grid with 4-neighbours, i.e. low degree and high diameter;
+ * - power-law: an R-MAT graph, i.e. skewed degrees and low diameter.
+ * All graphs are undirected, with random weights in [1, 1000]. Distances
+ * computed by Delta Stepping are checked against those of Dijkstra.
+ * A graph can also be loaded from a binary CSR Graph file (see the
+ * "csrconvert" program), e.g. to run on real road networks.
+ * Usage: sssp_bench [scale | graph file] [max threads]
+ * where 2^scale is the number of vertices of both graphs (default: 20).
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BenchUtils.h"
+#include "../Graphs/CSRGraph.h"
+#include "../Graphs/Dijkstra.h"
+#include "../Graphs/DeltaStepping.h"
+
+#define MAX_WEIGHT 1000
+
+/* Builds an undirected graph from a list of undirected edges. */
+CSRGraph *buildUndirected(ulong n, ulong m, uint32_t *src, uint32_t *dst,
+                          BenchRNG *rng) {
+    uint32_t *allSrc = calloc(2 * m, sizeof(uint32_t));
+    uint32_t *allDst = calloc(2 * m, sizeof(uint32_t));
+    uint32_t *weights = calloc(2 * m, sizeof(uint32_t));
+    CSRGraph *graph = NULL;
+    if ((allSrc != NULL) && (allDst != NULL) && (weights != NULL)) {
+        for (ulong i = 0; i < m; i++) {
+            uint32_t w = 1 + (uint32_t)benchRandomBelow(rng, MAX_WEIGHT);
+            allSrc[2 * i] = src[i];
+            allDst[2 * i] = dst[i];
+            allSrc[(2 * i) + 1] = dst[i];
+            allDst[(2 * i) + 1] = src[i];
+            weights[2 * i] = w;
+            weights[(2 * i) + 1] = w;
+        }
+        graph = createCSRGraph(n, 2 * m, allSrc, allDst, weights);
+    }
+    free(allSrc);
+    free(allDst);
+    free(weights);
+    return graph;
+}
+
+/* Builds a road-like grid graph with about n vertices. */
+CSRGraph *gridGraph(ulong n, BenchRNG *rng) {
+    ulong side = 1;
+    while (side * side < n) side++;
+    n = side * side;
+    ulong m = 2 * side * (side - 1);
+    uint32_t *src = calloc(m, sizeof(uint32_t));
+    uint32_t *dst = calloc(m, sizeof(uint32_t));
+    CSRGraph *graph = NULL;
+    if ((src != NULL) && (dst != NULL)) {
+        ulong e = 0;
+        for (ulong r = 0; r < side; r++) {
+            for (ulong c = 0; c < side; c++) {
+                ulong v = (r * side) + c;
+                if (c + 1 < side) {
+                    src[e] = (uint32_t)v;
+                    dst[e++] = (uint32_t)(v + 1);
+                }
+                if (r + 1 < side) {
+                    src[e] = (uint32_t)v;
+                    dst[e++] = (uint32_t)(v + side);
+                }
+            }
+        }
+        graph = buildUndirected(n, m, src, dst, rng);
+    }
+    free(src);
+    free(dst);
+    return graph;
+}
+
+/* Builds a power-law R-MAT graph with 2^scale vertices and average
+ * degree 16.
+ */
+CSRGraph *rmatGraph(ulong scale, BenchRNG *rng) {
+    ulong n = 1UL << scale;
+    ulong m = 8 * n;
+    uint32_t *src = calloc(m, sizeof(uint32_t));
+    uint32_t *dst = calloc(m, sizeof(uint32_t));
+    CSRGraph *graph = NULL;
+    if ((src != NULL) && (dst != NULL)) {
+        for (ulong e = 0; e < m; e++) {
+            // Quadrant probabilities: a = 0.57, b = 0.19, c = 0.19, d = 0.05.
+            ulong u = 0, v = 0;
+            for (ulong bit = 0; bit < scale; bit++) {
+                uint64_t r = benchRandomBelow(rng, 100);
+                u <<= 1;
+                v <<= 1;
+                if (r < 57) continue;
+                else if (r < 76) v |= 1;
+                else if (r < 95) u |= 1;
+                else {
+                    u |= 1;
+                    v |= 1;
+                }
+            }
+            src[e] = (uint32_t)u;
+            dst[e] = (uint32_t)v;
+        }
+        graph = buildUndirected(n, m, src, dst, rng);
+    }
+    free(src);
+    free(dst);
+    return graph;
+}
+
+/* Runs all algorithms on a graph, printing timings. */
+void benchGraph(const char *name, CSRGraph *graph, ulong maxThreads) {
+    ulong n = graph->verticesCount;
+    uint64_t *reference = calloc(n, sizeof(uint64_t));
+    uint64_t *dist = calloc(n, sizeof(uint64_t));
+    if ((reference == NULL) || (dist == NULL)) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    uint64_t start = benchNow();
+    dijkstra(graph, 0, reference);
+    double seqTime = (double)(benchNow() - start) / 1e6;
+    printf("%-10s %10lu %11lu  %-14s %7s %10.1f\n", name, n,
+           graph->edgesCount, "dijkstra-fib", "1", seqTime);
+    for (ulong threads = 1; threads <= maxThreads; threads *= 2) {
+        start = benchNow();
+        int ret = deltaStepping(graph, 0, 0, threads, dist);
+        double time = (double)(benchNow() - start) / 1e6;
+        int ok = (ret == 0) && !memcmp(dist, reference, n * sizeof(uint64_t));
+        printf("%-10s %10lu %11lu  %-14s %7lu %10.1f  x%.2f%s\n", name, n,
+               graph->edgesCount, "delta-stepping", threads, time,
+               seqTime / time, ok ? "" : "  MISMATCH");
+    }
+    free(reference);
+    free(dist);
+}
+
+int main(int argc, char **argv) {
+    char *end = NULL;
+    ulong scale = argc > 1 ? strtoul(argv[1], &end, 10) : 20;
+    ulong maxThreads = argc > 2 ? strtoul(argv[2], NULL, 10) : 64;
+    int fromFile = (end != NULL) && (*end != '\0');
+    if ((!fromFile && ((scale == 0) || (scale > 31))) || (maxThreads == 0)) {
+        fprintf(stderr, "Usage: %s [scale | graph file] [max threads]\n",
+                argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    BenchRNG rng;
+    benchSeed(&rng, 42);
+
+    printf("%-10s %10s %11s  %-14s %7s %10s\n", "graph", "vertices",
+           "edges", "algorithm", "threads", "time (ms)");
+    if (fromFile) {
+        uint64_t start = benchNow();
+        CSRGraph *graph = csrLoad(argv[1]);
+        if (graph == NULL) {
+            fprintf(stderr, "Failed to load %s.\n", argv[1]);
+            exit(EXIT_FAILURE);
+        }
+        fprintf(stderr, "Loaded in %.3f ms.\n",
+                (double)(benchNow() - start) / 1e6);
+        benchGraph("file", graph, maxThreads);
+        eraseCSRGraph(graph);
+        exit(EXIT_SUCCESS);
+    }
+    CSRGraph *road = gridGraph(1UL << scale, &rng);
+    CSRGraph *powerLaw = rmatGraph(scale, &rng);
+    if ((road == NULL) || (powerLaw == NULL)) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    benchGraph("road", road, maxThreads);
+    benchGraph("power-law", powerLaw, maxThreads);
+    eraseCSRGraph(road);
+    eraseCSRGraph(powerLaw);
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,117 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Benchmark of the Fibonacci Heap on a trace of heap operations, either
+ * recorded or synthetic (see the "tracegen" program in the Workloads
+ * directory). The trace is loaded in memory first, then replayed on a pooled
+ * heap with the element ID index; the time of each operation is measured
+ * and summed by operation type (so that times include the overhead of the
+ * clock, a few tens of nanoseconds per operation).
+ * Usage: trace_bench <trace file> [repetitions]
+ * (default: 1 repetition; the best time of each type is reported).
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "BenchUtils.h"
+#include "../Workloads/Workload.h"
+
+/* Loads a whole trace, exiting on failure. */
+WLOp *loadTrace(const char *path, ulong *opsCount) {
+    FILE *trace = fopen(path, "r");
+    if (trace == NULL) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    ulong cap = 1024, cnt = 0, lineNum = 0;
+    WLOp *ops = calloc(cap, sizeof(WLOp));
+    WLOp op;
+    int ret;
+    while ((ops != NULL) && ((ret = wlReadOp(trace, &op, &lineNum)) == 1)) {
+        if (cnt == cap) {
+            cap *= 2;
+            ops = reallocarray(ops, cap, sizeof(WLOp));
+            if (ops == NULL) break;
+        }
+        ops[cnt++] = op;
+    }
+    if (ops == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (ret != 0) {
+        fprintf(stderr, "%s:%lu: bad operation.\n", path, lineNum);
+        exit(EXIT_FAILURE);
+    }
+    fclose(trace);
+    *opsCount = cnt;
+    return ops;
+}
+
+/* Replays a trace, summing times by operation type.
+ * Returns 0 on success, -1 if an operation is invalid.
+ */
+int replay(WLOp *ops, ulong opsCount, uint64_t *times, ulong *counts,
+           ulong *maxSize) {
+    FibHeap *heap = createWLHeap();
+    if (heap == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    *maxSize = 0;
+    for (ulong i = 0; i < opsCount; i++) {
+        uint64_t start = benchNow();
+        if (wlApplyOp(heap, &(ops[i]), NULL, NULL) != 0) {
+            fprintf(stderr, "Operation %lu is invalid.\n", i + 1);
+            eraseFibHeap(heap, 0);
+            return -1;
+        }
+        times[ops[i].type] += benchNow() - start;
+        counts[ops[i].type]++;
+        if (heap->nodesCount > *maxSize) *maxSize = heap->nodesCount;
+    }
+    eraseFibHeap(heap, 0);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    static const char *names[WL_OP_TYPES] = {"insert", "delete-min", "delete",
+                                             "decrease", "increase"};
+    ulong reps = argc > 2 ? strtoul(argv[2], NULL, 10) : 1;
+    if ((argc < 2) || (argc > 3) || (reps == 0)) {
+        fprintf(stderr, "Usage: %s <trace file> [repetitions]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    ulong opsCount, maxSize = 0;
+    WLOp *ops = loadTrace(argv[1], &opsCount);
+    uint64_t best[WL_OP_TYPES];
+    ulong counts[WL_OP_TYPES] = {0};
+    for (ulong r = 0; r < reps; r++) {
+        uint64_t times[WL_OP_TYPES] = {0};
+        for (int j = 0; j < WL_OP_TYPES; j++) counts[j] = 0;
+        if (replay(ops, opsCount, times, counts, &maxSize) != 0)
+            exit(EXIT_FAILURE);
+        for (int j = 0; j < WL_OP_TYPES; j++)
+            if ((r == 0) || (times[j] < best[j])) best[j] = times[j];
+    }
+
+    printf("%lu operations, up to %lu elements in the heap\n", opsCount,
+           maxSize);
+    printf("%-10s %12s %12s %10s\n", "operation", "count", "time (ms)",
+           "ns/op");
+    uint64_t total = 0;
+    for (int j = 0; j < WL_OP_TYPES; j++) {
+        total += best[j];
+        if (counts[j] == 0) continue;
+        printf("%-10s %12lu %12.1f %10.1f\n", names[j], counts[j],
+               (double)best[j] / 1e6, (double)best[j] / (double)counts[j]);
+    }
+    printf("%-10s %12lu %12.1f %10.1f\n", "total", opsCount,
+           (double)total / 1e6, (double)total / (double)opsCount);
+    free(ops);
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,212 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Branch and Bound library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "BranchAndBound.h"
+
+/* Initial maximum tree order of the open list. */
+#define BB_INIT_TREE_ORD 16
+
+/* Search state, shared among all search threads.
+ * The open list and the best solution are protected by the lock, while the
+ * incumbent value can be read at any time to prune subproblems early.
+ */
+typedef struct {
+    BBProblem *problem;
+    FibHeap *open;                // Open subproblems, keyed by bound.
+    pthread_mutex_t lock;
+    pthread_cond_t wakeUp;        // Signals new work or the end of the search.
+    _Atomic uint64_t incumbent;   // Value of the best solution found.
+    void *best;                   // Best solution found.
+    ulong busy;                   // Threads currently expanding a subproblem.
+    ulong expanded;
+    ulong pruned;
+    ulong dropped;
+    int failed;                   // Set if an allocation failed.
+} BBSearch;
+
+/* Declarations of internal library subroutines. */
+void *_bbWorker(void *arg);
+void _bbNewIncumbent(BBSearch *search, void *sol, uint64_t value);
+void _bbPruneOpen(BBSearch *search);
+
+// LIBRARY FUNCTIONS //
+/* Solves a problem starting from a root subproblem, which is taken over by
+ * the library. Returns 0 if the search completed, -1 on failure (in which
+ * case the result holds the best solution found until then).
+ */
+int bbSolve(BBProblem *problem, void *root, BBResult *result) {
+    if ((problem == NULL) || (root == NULL) || (result == NULL)) return -1;
+    if ((problem->bound == NULL) || (problem->isSolution == NULL) ||
+        (problem->branch == NULL) || (problem->maxSons == 0)) return -1;
+
+    BBSearch search;
+    search.problem = problem;
+    search.open = createFibHeap(BB_INIT_TREE_ORD);
+    if (search.open == NULL) return -1;
+    pthread_mutex_init(&(search.lock), NULL);
+    pthread_cond_init(&(search.wakeUp), NULL);
+    atomic_init(&(search.incumbent), UINT64_MAX);
+    search.best = NULL;
+    search.busy = 0;
+    search.expanded = 0;
+    search.pruned = 0;
+    search.dropped = 0;
+    search.failed = 0;
+
+    if (fhInsert(search.open, root, problem->bound(root, problem->ctx)) ==
+        NULL) {
+        free(root);
+        search.failed = 1;
+    }
+
+    // Start the search threads, the calling one included.
+    if (!search.failed) {
+        ulong threadsCnt = problem->threads > 1 ? problem->threads : 1;
+        pthread_t *threads = calloc(threadsCnt, sizeof(pthread_t));
+        ulong started = 0;
+        if (threads != NULL) {
+            for (ulong i = 1; i < threadsCnt; i++) {
+                if (pthread_create(&(threads[i]), NULL, _bbWorker, &search))
+                    break;  // Go on with the ones we got.
+                started++;
+            }
+        }
+        _bbWorker(&search);
+        for (ulong i = 1; i <= started; i++) pthread_join(threads[i], NULL);
+        free(threads);
+    }
+
+    result->best = search.best;
+    result->bestValue = atomic_load(&(search.incumbent));
+    result->expanded = search.expanded;
+    result->pruned = search.pruned;
+    result->dropped = search.dropped;
+    result->optimal = (!search.failed) && (search.dropped == 0);
+
+    eraseFibHeap(search.open, DELETE_FREE_DATA);
+    pthread_cond_destroy(&(search.wakeUp));
+    pthread_mutex_destroy(&(search.lock));
+    return search.failed ? -1 : 0;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Search thread routine: expands subproblems until none is left. */
+void *_bbWorker(void *arg) {
+    BBSearch *search = (BBSearch *)arg;
+    BBProblem *problem = search->problem;
+    ulong expanded = 0, pruned = 0;
+    void **sons = calloc(problem->maxSons, sizeof(void *));
+    uint64_t *bounds = calloc(problem->maxSons, sizeof(uint64_t));
+
+    pthread_mutex_lock(&(search->lock));
+    if ((sons == NULL) || (bounds == NULL)) search->failed = 1;
+    while (1) {
+        // Wait for work, unless nobody can produce any more of it.
+        while ((search->open->min == NULL) && (search->busy > 0) &&
+               !(search->failed))
+            pthread_cond_wait(&(search->wakeUp), &(search->lock));
+        if ((search->open->min == NULL) || search->failed) break;
+        FibTreeNode *minNode = fhDeleteMin(search->open);
+        search->busy++;
+        pthread_mutex_unlock(&(search->lock));
+
+        void *sub = minNode->elem;
+        uint64_t bound = minNode->key;
+        eraseFibTreeNode(minNode, 0);
+        uint64_t value;
+        ulong sonsCnt = 0;
+        if (bound >= atomic_load(&(search->incumbent))) {
+            // Someone found a better solution in the meantime.
+            free(sub);
+            pruned++;
+        } else if (problem->isSolution(sub, &value, problem->ctx)) {
+            if (value < atomic_load(&(search->incumbent))) {
+                pthread_mutex_lock(&(search->lock));
+                _bbNewIncumbent(search, sub, value);
+                pthread_mutex_unlock(&(search->lock));
+            } else free(sub);
+        } else {
+            sonsCnt = problem->branch(sub, sons, problem->maxSons,
+                                      problem->ctx);
+            free(sub);
+            expanded++;
+            // Bound the sons before taking the lock.
+            for (ulong i = 0; i < sonsCnt; i++) {
+                bounds[i] = problem->bound(sons[i], problem->ctx);
+                if (bounds[i] >= atomic_load(&(search->incumbent))) {
+                    free(sons[i]);
+                    sons[i] = NULL;
+                    pruned++;
+                }
+            }
+        }
+
+        pthread_mutex_lock(&(search->lock));
+        for (ulong i = 0; i < sonsCnt; i++) {
+            if (sons[i] == NULL) continue;
+            if (fhInsert(search->open, sons[i], bounds[i]) == NULL) {
+                free(sons[i]);
+                search->failed = 1;
+            }
+        }
+        if ((problem->maxOpenNodes > 0) &&
+            (search->open->nodesCount > problem->maxOpenNodes)) {
+            // Drop a good share of the worst subproblems at once, since the
+            // selection costs a full scan of the open list.
+            ulong keep = problem->maxOpenNodes - (problem->maxOpenNodes / 4);
+            search->dropped += fhDeleteWorst(search->open,
+                                             search->open->nodesCount - keep,
+                                             DELETE_FREE_DATA);
+        }
+        search->busy--;
+        pthread_cond_broadcast(&(search->wakeUp));
+    }
+    search->expanded += expanded;
+    search->pruned += pruned;
+    pthread_cond_broadcast(&(search->wakeUp));
+    pthread_mutex_unlock(&(search->lock));
+    free(sons);
+    free(bounds);
+    return NULL;
+}
+
+/* Stores a new best solution, and prunes the open list accordingly.
+ * Must be called with the lock held.
+ */
+void _bbNewIncumbent(BBSearch *search, void *sol, uint64_t value) {
+    if (value >= atomic_load(&(search->incumbent))) {
+        // Someone else got here first with a better one.
+        free(sol);
+        return;
+    }
+    free(search->best);
+    search->best = sol;
+    atomic_store(&(search->incumbent), value);
+    _bbPruneOpen(search);
+}
+
+/* Drops all open subproblems that can't beat the incumbent.
+ * Must be called with the lock held.
+ */
+void _bbPruneOpen(BBSearch *search) {
+    uint64_t incumbent = atomic_load(&(search->incumbent));
+    if (incumbent > 0)
+        search->pruned += fhDeleteAbove(search->open, incumbent - 1,
+                                        DELETE_FREE_DATA);
+    else
+        search->pruned += fhDeleteWorst(search->open,
+                                        search->open->nodesCount,
+                                        DELETE_FREE_DATA);
+}
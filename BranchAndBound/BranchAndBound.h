@@ -0,0 +1,66 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Branch and
+ * Bound library, a best-first search framework built on top of the Fibonacci
+ * Heap library, which is used as the list of open subproblems.
+ * Problems are minimization problems: the user provides callbacks to compute
+ * a lower bound for a subproblem, to tell whether a subproblem is a complete
+ * solution, and to branch a subproblem into smaller ones. Subproblems are
+ * expanded in order of increasing bound, and all open subproblems whose bound
+ * can't beat the best solution found so far (the "incumbent") are dropped at
+ * once as soon as a better solution is found.
+ * The search can run on multiple threads, which share the open list and the
+ * incumbent, and can be bounded in memory: when too many subproblems are
+ * open, the ones with the worst bounds are dropped.
+ * NOTE: Subproblems are "void *s" that must be allocated with malloc and
+ * friends, since they are freed by the library when they are expanded or
+ * pruned. The best solution found is handed to the caller, which must free it.
+ * NOTE: When the search is bounded in memory and some subproblems are dropped,
+ * the solution found is not guaranteed to be optimal (see "BBResult").
+ * NOTE: With multiple threads, the callbacks are called concurrently and must
+ * be thread-safe.
+ * NOTE: This library requires the Fibonacci Heap library and POSIX threads.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef BRANCHANDBOUND_H
+#define BRANCHANDBOUND_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Branch and Bound problem description.
+ * Stores the callbacks that define the problem, and search parameters.
+ */
+typedef struct {
+    // Returns a lower bound on the value of all solutions in a subproblem.
+    uint64_t (*bound)(void *sub, void *ctx);
+    // Returns 1 if a subproblem is a complete solution, storing its value.
+    int (*isSolution)(void *sub, uint64_t *value, void *ctx);
+    // Stores at most maxSons new subproblems in sons, returning how many.
+    ulong (*branch)(void *sub, void **sons, ulong maxSons, void *ctx);
+    void *ctx;                // User data passed to the callbacks.
+    ulong maxSons;            // Maximum number of sons of a subproblem.
+    ulong maxOpenNodes;       // Maximum open subproblems (0 for no limit).
+    ulong threads;            // Number of search threads (0 or 1: serial).
+} BBProblem;
+
+/* Branch and Bound search result and statistics. */
+typedef struct {
+    void *best;               // Best solution found (NULL if none).
+    uint64_t bestValue;       // Its value (UINT64_MAX if none).
+    ulong expanded;           // Number of subproblems branched.
+    ulong pruned;             // Number of subproblems pruned by bounds.
+    ulong dropped;            // Number of subproblems dropped to save memory.
+    int optimal;              // 1 if the search was exhaustive.
+} BBResult;
+
+/* Library functions. */
+int bbSolve(BBProblem *problem, void *root, BBResult *result);
+
+#endif
@@ -0,0 +1,207 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Bucket Queue library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+
+#include "BucketQueue_uint64-keys.h"
+
+/* Declarations of internal library subroutines. */
+BQItem *_newItem(BucketQueue *queue);
+void _bucketAppend(BucketQueue *queue, BQItem *item);
+void _bucketRemove(BucketQueue *queue, BQItem *item);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new Bucket Queue. */
+BucketQueue *createBucketQueue(void) {
+    // Buckets and bitmaps all start zeroed.
+    BucketQueue *newQueue = calloc(1, sizeof(BucketQueue));
+    if (newQueue == NULL) return NULL;
+    newQueue->_pool._chunks = NULL;
+    newQueue->_pool._freeList = NULL;
+    return newQueue;
+}
+
+/* Destroys a Bucket Queue, freeing memory. */
+void eraseBucketQueue(BucketQueue *queue, int opts) {
+    if (queue == NULL) return;
+    if (opts & DELETE_FREE_DATA) {
+        for (ulong i = 0; i < BQ_LEVELS; i++)
+            for (BQItem *curr = (queue->_buckets)[i]._first; curr != NULL;
+                 curr = curr->_next)
+                free(curr->elem);
+    }
+    for (ulong i = 0; i < queue->_pool._chunksCnt; i++)
+        free((queue->_pool._chunks)[i]);
+    free(queue->_pool._chunks);
+    free(queue);
+}
+
+/* Deletes a given item, giving it back to its pool. */
+void eraseBQItem(BQItem *item, int opts) {
+    if (item == NULL) return;
+    if (opts & DELETE_FREE_DATA) free(item->elem);
+    BQPool *pool = item->_pool;
+    item->_prev = NULL;
+    item->_queued = 0;
+    item->_gen++;
+    if (item->_gen == 0) item->_gen = 1;  // Keep handles nonzero.
+    item->_next = pool->_freeList;
+    pool->_freeList = item;
+}
+
+/* Tells whether a given queue is empty or not. */
+int isBucketQueueEmpty(BucketQueue *queue) {
+    if (queue == NULL) return -1;
+    return queue->_summary == 0;
+}
+
+/* Creates a new item and adds it to the back of its bucket.
+ * Returns NULL if the key is too big, or on failure.
+ */
+BQItem *bqInsert(BucketQueue *queue, void *elem, uint64_t key) {
+    if ((queue == NULL) || (key >= BQ_LEVELS)) return NULL;
+    BQItem *newItem = _newItem(queue);
+    if (newItem == NULL) return NULL;
+    newItem->key = key;
+    newItem->elem = elem;
+    _bucketAppend(queue, newItem);
+    queue->itemsCount++;
+    return newItem;
+}
+
+/* Returns the first item with the minimum key, without deleting it. */
+BQItem *bqFindMin(BucketQueue *queue) {
+    if ((queue == NULL) || (queue->_summary == 0)) return NULL;
+    ulong word = (ulong)__builtin_ctzll(queue->_summary);
+    ulong bit = (ulong)__builtin_ctzll((queue->_levels)[word]);
+    return (queue->_buckets)[(word * 64) + bit]._first;
+}
+
+/* Deletes the first item with the minimum key and returns it. */
+BQItem *bqDeleteMin(BucketQueue *queue) {
+    return bqDelete(queue, bqFindMin(queue));
+}
+
+/* Deletes an item from the queue and returns it. */
+BQItem *bqDelete(BucketQueue *queue, BQItem *item) {
+    if ((queue == NULL) || (item == NULL)) return NULL;
+    _bucketRemove(queue, item);
+    queue->itemsCount--;
+    return item;
+}
+
+/* Decreases item's key of dec (key -= dec), moving it to the back of its new
+ * bucket. Returns a pointer to the item, or NULL if dec is greater than its
+ * key.
+ */
+BQItem *bqDecreaseKey(BucketQueue *queue, BQItem *item, uint64_t dec) {
+    if ((queue == NULL) || (item == NULL) || (dec > item->key)) return NULL;
+    _bucketRemove(queue, item);
+    item->key -= dec;
+    _bucketAppend(queue, item);
+    return item;
+}
+
+/* Increases item's key of inc (key += inc), moving it to the back of its new
+ * bucket. Returns a pointer to the item, or NULL if the new key would be too
+ * big.
+ */
+BQItem *bqIncreaseKey(BucketQueue *queue, BQItem *item, uint64_t inc) {
+    if ((queue == NULL) || (item == NULL)) return NULL;
+    if (inc >= BQ_LEVELS - item->key) return NULL;
+    _bucketRemove(queue, item);
+    item->key += inc;
+    _bucketAppend(queue, item);
+    return item;
+}
+
+/* Returns a handle to an item. */
+BQHandle bqHandle(BQItem *item) {
+    if (item == NULL) return BQ_NULL_HANDLE;
+    return ((BQHandle)(item->_gen) << 32) | item->_poolIdx;
+}
+
+/* Resolves a handle to its item, in constant time.
+ * Returns NULL if the item has been erased or isn't in the queue anymore.
+ */
+BQItem *bqResolve(BucketQueue *queue, BQHandle handle) {
+    if (queue == NULL) return NULL;
+    ulong idx = handle & UINT32_MAX;
+    if (idx >= queue->_pool._used) return NULL;
+    BQItem *item = &((queue->_pool._chunks)[idx >> BQ_POOL_CHUNK_ORD]
+                     [idx & ((1UL << BQ_POOL_CHUNK_ORD) - 1)]);
+    if ((item->_gen != (uint32_t)(handle >> 32)) || !(item->_queued))
+        return NULL;
+    return item;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Takes a new item from the pool. Returns NULL on failure. */
+BQItem *_newItem(BucketQueue *queue) {
+    BQPool *pool = &(queue->_pool);
+    BQItem *item = pool->_freeList;
+    if (item != NULL) {
+        pool->_freeList = item->_next;
+        item->_next = NULL;
+        return item;
+    }
+    // Take a new item from the last chunk, adding one if needed.
+    if (pool->_used > UINT32_MAX) return NULL;  // Indexes are exhausted.
+    ulong chunkSize = 1UL << BQ_POOL_CHUNK_ORD;
+    if (pool->_used == pool->_chunksCnt * chunkSize) {
+        BQItem **newChunks = reallocarray(pool->_chunks, pool->_chunksCnt + 1,
+                                          sizeof(BQItem *));
+        if (newChunks == NULL) return NULL;
+        pool->_chunks = newChunks;
+        newChunks[pool->_chunksCnt] = calloc(chunkSize, sizeof(BQItem));
+        if (newChunks[pool->_chunksCnt] == NULL) return NULL;
+        pool->_chunksCnt++;
+    }
+    item = &((pool->_chunks)[pool->_used >> BQ_POOL_CHUNK_ORD]
+             [pool->_used & (chunkSize - 1)]);
+    item->_pool = pool;
+    item->_poolIdx = (uint32_t)(pool->_used);
+    item->_gen = 1;
+    pool->_used++;
+    return item;
+}
+
+/* Appends an item to the bucket of its key, updating the summary. */
+void _bucketAppend(BucketQueue *queue, BQItem *item) {
+    BQBucket *bucket = &((queue->_buckets)[item->key]);
+    item->_next = NULL;
+    item->_prev = bucket->_last;
+    if (bucket->_last != NULL) bucket->_last->_next = item;
+    else {
+        bucket->_first = item;
+        (queue->_levels)[item->key / 64] |= 1ULL << (item->key % 64);
+        queue->_summary |= 1ULL << (item->key / 64);
+    }
+    bucket->_last = item;
+    item->_queued = 1;
+}
+
+/* Removes an item from its bucket, updating the summary. */
+void _bucketRemove(BucketQueue *queue, BQItem *item) {
+    BQBucket *bucket = &((queue->_buckets)[item->key]);
+    if (item->_prev != NULL) item->_prev->_next = item->_next;
+    else bucket->_first = item->_next;
+    if (item->_next != NULL) item->_next->_prev = item->_prev;
+    else bucket->_last = item->_prev;
+    if (bucket->_first == NULL) {
+        (queue->_levels)[item->key / 64] &= ~(1ULL << (item->key % 64));
+        if ((queue->_levels)[item->key / 64] == 0)
+            queue->_summary &= ~(1ULL << (item->key / 64));
+    }
+    item->_next = NULL;
+    item->_prev = NULL;
+    item->_queued = 0;
+}
@@ -0,0 +1,110 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Bucket Queue
+ * library, a priority queue for small integer keys in [0, BQ_LEVELS), e.g.
+ * priority levels of packet or job schedulers. Elements are "void *s", as in
+ * the Fibonacci Heap.
+ * Each key has a FIFO bucket of items, and non-empty buckets are tracked by a
+ * two-level summary of 64-bit bitmaps: one bit for each bucket, and one bit
+ * for each word of the first level. So, the minimum key is found with two
+ * "count trailing zeros" instructions, and all other operations take
+ * constant time too.
+ * Items work as Fibonacci Heap nodes: the ones returned by insertions can be
+ * used to modify or delete elements, and the ones returned by deletions
+ * belong to the caller. They come from a pool, as in pooled Fibonacci Heaps,
+ * and can be referred to with handles of the same format: "bqHandle" and
+ * "bqResolve" work as "fhHandle" and "fhResolve".
+ * Functions intended to be used are marked as such, whilst other internal
+ * subroutines should not be used outside of these source files.
+ * See other comments for specific descriptions of functions and data
+ * structures.
+ * NOTE: Items with the same key are deleted in insertion order. An item whose
+ * key is modified goes to the back of its new bucket.
+ * NOTE: Keys outside of [0, BQ_LEVELS) are rejected, i.e. the operations that
+ * get one fail.
+ * NOTE: Items's elements could be pointers to the heap as well. A binary flag
+ * is provided to free them when total queue deletion is called.
+ * WARNING: Items live as long as their queue: items deleted from the queue and
+ * not yet erased are invalidated when the queue is erased.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef BUCKETQUEUE_UINT64_KEYS_H
+#define BUCKETQUEUE_UINT64_KEYS_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* This option can be passed to the delete functions to specify if also the
+ * elements in the items must be freed in the queue.
+ * If nothing is specified, only the items are freed.
+ */
+#define DELETE_FREE_DATA 0x1
+
+/* Number of keys, i.e. buckets: one bit for each in a two-level summary. */
+#define BQ_LEVELS 4096
+
+/* Item pools are grown in chunks of 2^BQ_POOL_CHUNK_ORD items. */
+#define BQ_POOL_CHUNK_ORD 10
+
+/* Handle to an item: generation in the upper 32 bits, index in the pool in
+ * the lower ones, as for Fibonacci Heap nodes. No handle is 0.
+ */
+typedef uint64_t BQHandle;
+#define BQ_NULL_HANDLE 0
+
+/* Bucket Queue Item. Stores an element and its key. */
+typedef struct __bqItem {
+    uint64_t key;                    // Keys in [0, BQ_LEVELS).
+    void *elem;                      // Element stored in the item.
+    struct __bqItem *_next;          // Next item in the bucket.
+    struct __bqItem *_prev;          // Previous item in the bucket.
+    struct __bqPool *_pool;          // Pool the item belongs to.
+    uint32_t _poolIdx;               // Index of the item in its pool.
+    uint32_t _gen;                   // Generation of the item in its pool.
+    unsigned char _queued;           // Set while the item is in the queue.
+} BQItem;
+
+/* Bucket Queue Items Pool. Erased items are kept in a free list, linked
+ * through their "_next" field.
+ */
+typedef struct __bqPool {
+    BQItem **_chunks;
+    ulong _chunksCnt;
+    ulong _used;
+    BQItem *_freeList;
+} BQPool;
+
+/* Bucket of items with the same key. */
+typedef struct {
+    BQItem *_first;
+    BQItem *_last;
+} BQBucket;
+
+/* Bucket Queue. */
+typedef struct {
+    BQBucket _buckets[BQ_LEVELS];
+    uint64_t _levels[BQ_LEVELS / 64];    // Non-empty buckets.
+    uint64_t _summary;                   // Non-zero words of "_levels".
+    BQPool _pool;
+    ulong itemsCount;
+} BucketQueue;
+
+/* Library functions. */
+BucketQueue *createBucketQueue(void);
+void eraseBucketQueue(BucketQueue *queue, int opts);
+void eraseBQItem(BQItem *item, int opts);
+int isBucketQueueEmpty(BucketQueue *queue);
+BQItem *bqInsert(BucketQueue *queue, void *elem, uint64_t key);
+BQItem *bqFindMin(BucketQueue *queue);
+BQItem *bqDeleteMin(BucketQueue *queue);
+BQItem *bqDelete(BucketQueue *queue, BQItem *item);
+BQItem *bqDecreaseKey(BucketQueue *queue, BQItem *item, uint64_t dec);
+BQItem *bqIncreaseKey(BucketQueue *queue, BQItem *item, uint64_t inc);
+BQHandle bqHandle(BQItem *item);
+BQItem *bqResolve(BucketQueue *queue, BQHandle handle);
+
+#endif
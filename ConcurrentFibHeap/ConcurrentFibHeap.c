@@ -0,0 +1,179 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Concurrent Fibonacci Heap library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <sched.h>
+
+#include "ConcurrentFibHeap.h"
+
+/* States of elimination slots. */
+#define CFH_SLOT_EMPTY 0
+#define CFH_SLOT_WAITING 1
+#define CFH_SLOT_BUSY 2
+#define CFH_SLOT_FULL 3
+
+/* Declarations of internal library subroutines. */
+int _offer(ConcurrentFibHeap *cfh, void *elem, uint64_t key);
+int _wait(ConcurrentFibHeap *cfh, void **elem, uint64_t *key);
+void _publishMin(ConcurrentFibHeap *cfh);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new Concurrent Fibonacci Heap, with a given
+ * number of elimination slots (CFH_DEFAULT_SLOTS if 0). The initial maximum
+ * tree order is that of the heap (see "createFibHeap").
+ */
+ConcurrentFibHeap *createConcurrentFibHeap(ulong initMaxTreeOrd,
+                                           ulong slotsCnt) {
+    if (slotsCnt == 0) slotsCnt = CFH_DEFAULT_SLOTS;
+    ConcurrentFibHeap *newCfh = calloc(1, sizeof(ConcurrentFibHeap));
+    if (newCfh == NULL) return NULL;
+    newCfh->_heap = createFibHeap(initMaxTreeOrd);
+    newCfh->_slots = aligned_alloc(CFH_CACHE_LINE,
+                                   slotsCnt * sizeof(CFHSlot));
+    if ((newCfh->_heap == NULL) || (newCfh->_slots == NULL) ||
+        pthread_mutex_init(&(newCfh->_lock), NULL)) {
+        eraseFibHeap(newCfh->_heap, 0);
+        free(newCfh->_slots);
+        free(newCfh);
+        return NULL;
+    }
+    for (ulong i = 0; i < slotsCnt; i++) {
+        atomic_init(&((newCfh->_slots)[i]._state), CFH_SLOT_EMPTY);
+        (newCfh->_slots)[i]._key = 0;
+        (newCfh->_slots)[i]._elem = NULL;
+    }
+    newCfh->slotsCount = slotsCnt;
+    atomic_init(&(newCfh->_minKey), UINT64_MAX);
+    atomic_init(&(newCfh->_nextSlot), 0);
+    atomic_init(&(newCfh->eliminated), 0);
+    return newCfh;
+}
+
+/* Destroys a Concurrent Fibonacci Heap, freeing memory. No other thread must
+ * be using it.
+ */
+void eraseConcurrentFibHeap(ConcurrentFibHeap *cfh, int opts) {
+    if (cfh == NULL) return;
+    eraseFibHeap(cfh->_heap, opts);
+    pthread_mutex_destroy(&(cfh->_lock));
+    free(cfh->_slots);
+    free(cfh);
+}
+
+/* Tells whether a given heap is empty or not, as of the last operation that
+ * held the lock.
+ */
+int isConcurrentFibHeapEmpty(ConcurrentFibHeap *cfh) {
+    if (cfh == NULL) return -1;
+    pthread_mutex_lock(&(cfh->_lock));
+    int empty = cfh->_heap->nodesCount == 0;
+    pthread_mutex_unlock(&(cfh->_lock));
+    return empty;
+}
+
+/* Adds an element to the heap, or hands it over to a waiting minimum
+ * deletion if its key is not greater than the minimum one.
+ * Returns 0 on success, -1 on failure.
+ */
+int cfhInsert(ConcurrentFibHeap *cfh, void *elem, uint64_t key) {
+    if (cfh == NULL) return -1;
+    if ((key <= atomic_load(&(cfh->_minKey))) && _offer(cfh, elem, key))
+        return 0;
+    pthread_mutex_lock(&(cfh->_lock));
+    FibTreeNode *newNode = fhInsert(cfh->_heap, elem, key);
+    if (newNode != NULL) _publishMin(cfh);
+    pthread_mutex_unlock(&(cfh->_lock));
+    return newNode != NULL ? 0 : -1;
+}
+
+/* Deletes the element with the minimum key, storing it and its key (either
+ * pointer can be NULL). If the lock is busy, waits for an insertion to hand
+ * over its element for a while first.
+ * Returns 0 on success, -1 if the heap is empty.
+ */
+int cfhDeleteMin(ConcurrentFibHeap *cfh, void **elem, uint64_t *key) {
+    if (cfh == NULL) return -1;
+    if (pthread_mutex_trylock(&(cfh->_lock))) {
+        if (_wait(cfh, elem, key)) return 0;
+        pthread_mutex_lock(&(cfh->_lock));
+    }
+    FibTreeNode *min = fhDeleteMin(cfh->_heap);
+    if (min != NULL) _publishMin(cfh);
+    pthread_mutex_unlock(&(cfh->_lock));
+    if (min == NULL) return -1;
+    if (elem != NULL) *elem = min->elem;
+    if (key != NULL) *key = min->key;
+    eraseFibTreeNode(min, 0);
+    return 0;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Looks for a waiting deletion and hands an element over to it.
+ * Returns 1 on success, 0 if no deletion was waiting.
+ */
+int _offer(ConcurrentFibHeap *cfh, void *elem, uint64_t key) {
+    ulong start = atomic_load_explicit(&(cfh->_nextSlot),
+                                       memory_order_relaxed);
+    for (ulong i = 0; i < cfh->slotsCount; i++) {
+        CFHSlot *slot = &((cfh->_slots)[(start + i) % cfh->slotsCount]);
+        int expected = CFH_SLOT_WAITING;
+        if ((atomic_load_explicit(&(slot->_state), memory_order_relaxed) !=
+             expected) ||
+            !atomic_compare_exchange_strong(&(slot->_state), &expected,
+                                            CFH_SLOT_BUSY)) continue;
+        slot->_elem = elem;
+        slot->_key = key;
+        atomic_store_explicit(&(slot->_state), CFH_SLOT_FULL,
+                              memory_order_release);
+        atomic_fetch_add_explicit(&(cfh->eliminated), 1,
+                                  memory_order_relaxed);
+        return 1;
+    }
+    return 0;
+}
+
+/* Waits in an elimination slot for an insertion to hand over an element,
+ * storing it and its key.
+ * Returns 1 on success, 0 if no slot was free or nothing came in time.
+ */
+int _wait(ConcurrentFibHeap *cfh, void **elem, uint64_t *key) {
+    ulong idx = atomic_fetch_add_explicit(&(cfh->_nextSlot), 1,
+                                          memory_order_relaxed);
+    CFHSlot *slot = &((cfh->_slots)[idx % cfh->slotsCount]);
+    int expected = CFH_SLOT_EMPTY;
+    if (!atomic_compare_exchange_strong(&(slot->_state), &expected,
+                                        CFH_SLOT_WAITING)) return 0;
+    for (int i = 0; i < CFH_ELIM_SPINS; i++) {
+        if (atomic_load_explicit(&(slot->_state), memory_order_acquire) ==
+            CFH_SLOT_FULL) break;
+        sched_yield();
+    }
+    // Leave, unless an insertion got here in the meantime: then wait for it
+    // to finish writing.
+    expected = CFH_SLOT_WAITING;
+    if (atomic_compare_exchange_strong(&(slot->_state), &expected,
+                                       CFH_SLOT_EMPTY)) return 0;
+    while (atomic_load_explicit(&(slot->_state), memory_order_acquire) !=
+           CFH_SLOT_FULL) sched_yield();
+    if (elem != NULL) *elem = slot->_elem;
+    if (key != NULL) *key = slot->_key;
+    atomic_store_explicit(&(slot->_state), CFH_SLOT_EMPTY,
+                          memory_order_release);
+    return 1;
+}
+
+/* Publishes the current minimum key, for insertions to check. Must be called
+ * with the lock held.
+ */
+void _publishMin(ConcurrentFibHeap *cfh) {
+    FibTreeNode *min = cfh->_heap->min;
+    atomic_store(&(cfh->_minKey), min != NULL ? min->key : UINT64_MAX);
+}
@@ -0,0 +1,79 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Concurrent
+ * Fibonacci Heap library, a priority queue that can be shared by many
+ * threads. It is built on top of the Fibonacci Heap library: the heap is
+ * protected by a lock, and fronted by an elimination array.
+ * A minimum deletion that finds the lock busy waits for a while in a slot of
+ * the array, instead of queueing on the lock. An insertion whose key is not
+ * greater than the current minimum looks for such a waiting deletion first,
+ * and if it finds one it hands over its element directly: the pair of
+ * operations completes without touching the heap or its lock, as if the
+ * insertion had been immediately followed by the deletion.
+ * Since nodes never leave the library, elements are passed by value together
+ * with their keys, as in the Sequence Heap.
+ * NOTE: The minimum key seen by insertions is the one published by the last
+ * operation that held the lock, so an element can be handed over while a
+ * concurrent insertion is adding a smaller key to the heap. Operations that
+ * overlap in time can thus complete in either order.
+ * NOTE: Elements could be pointers to the heap as well. A binary flag is
+ * provided to free them when total heap deletion is called.
+ * NOTE: This library requires the Fibonacci Heap library, POSIX threads and
+ * C11 atomics.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef CONCURRENTFIBHEAP_H
+#define CONCURRENTFIBHEAP_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Size of a cache line, so that elimination slots don't share one. */
+#define CFH_CACHE_LINE 64
+
+/* Default number of elimination slots. */
+#define CFH_DEFAULT_SLOTS 8
+
+/* Times a waiting deletion checks its slot before giving up (yielding the
+ * processor in between).
+ */
+#define CFH_ELIM_SPINS 64
+
+/* Elimination slot. Its state goes from empty to waiting (a deletion is
+ * there), to busy (an insertion is writing in it), to full, and back to
+ * empty once the deletion takes the element.
+ */
+typedef struct {
+    _Alignas(CFH_CACHE_LINE) _Atomic int _state;
+    uint64_t _key;
+    void *_elem;
+} CFHSlot;
+
+/* Concurrent Fibonacci Heap. */
+typedef struct {
+    pthread_mutex_t _lock;
+    FibHeap *_heap;
+    _Atomic uint64_t _minKey;        // UINT64_MAX if the heap is empty.
+    CFHSlot *_slots;
+    ulong slotsCount;
+    _Atomic ulong _nextSlot;         // Spreads deletions among slots.
+    _Atomic ulong eliminated;        // Insertions handed over so far.
+} ConcurrentFibHeap;
+
+/* Library functions. */
+ConcurrentFibHeap *createConcurrentFibHeap(ulong initMaxTreeOrd,
+                                           ulong slotsCnt);
+void eraseConcurrentFibHeap(ConcurrentFibHeap *cfh, int opts);
+int isConcurrentFibHeapEmpty(ConcurrentFibHeap *cfh);
+int cfhInsert(ConcurrentFibHeap *cfh, void *elem, uint64_t key);
+int cfhDeleteMin(ConcurrentFibHeap *cfh, void **elem, uint64_t *key);
+
+#endif
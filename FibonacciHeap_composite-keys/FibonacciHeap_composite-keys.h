@@ -0,0 +1,127 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Fibonacci Heap
+ * library with composite keys. Keys are tuples of up to four unsigned integer
+ * fields, compared lexicographically (e.g. priority, then timestamp, then id),
+ * and elements are "void *s", so anything that fits in 8 bytes will do.
+ * As a priority queue, this structure offers insertions, deletions, minimum
+ * key search and key modifications on a specific node.
+ * Functions intended to be used are marked as such, whilst other internal
+ * subroutines should not be used outside of these source files.
+ * See other comments for specific descriptions of functions and data
+ * structures.
+ * The number of fields and their type are fixed at compile time by defining
+ * FH_KEY_FIELDS (1 to 4, default 3) and FH_KEY_FIELD_T (an unsigned integer
+ * type, default uint64_t), so that key comparisons are unrolled and keys are
+ * stored inline in the nodes, without any indirection. The same definitions
+ * must be used to compile this library and the code that includes it.
+ * WARNING: It is possible to have nodes with same keys in this structure. In
+ * such case, node pointers should be preferred to operate on data to avoid
+ * aliasing.
+ * NOTE: Since keys can't be added or subtracted, key modifications take the
+ * new key instead of a difference, and fail if it goes the wrong way.
+ * NOTE: This structure requires Double Linked Lists to work, and uses the copy
+ * that comes with the uint64 keys library.
+ * NOTE: Nodes's contents could be pointers to the heap as well. A binary flag
+ * is provided to free them when total heap deletion is called.
+ * WARNING: This library exports the same names as the uint64 keys one, so the
+ * two can't be linked in the same program.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef FIBONACCIHEAP_COMPOSITE_KEYS_H
+#define FIBONACCIHEAP_COMPOSITE_KEYS_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/double-linked-lists_c/DoubleLinkedList/doubleLinkedList.h"
+
+/* Number of fields in a key. */
+#ifndef FH_KEY_FIELDS
+#define FH_KEY_FIELDS 3
+#endif
+#if (FH_KEY_FIELDS < 1) || (FH_KEY_FIELDS > 4)
+#error "FH_KEY_FIELDS must be between 1 and 4"
+#endif
+
+/* Type of the fields in a key. */
+#ifndef FH_KEY_FIELD_T
+#define FH_KEY_FIELD_T uint64_t
+#endif
+
+/* These options can be OR'd in a call to the delete functions to specify
+ * if also the data in the nodes must be freed in the heap.
+ * If nothing is specified, only the nodes are freed.
+ */
+#define DELETE_FREE_DATA 0x1
+
+/* Composite key. The first field is the most significant one. */
+typedef struct {
+    FH_KEY_FIELD_T fields[FH_KEY_FIELDS];
+} FibKey;
+
+/* Fibonacci Tree Node.
+ * Stores a key, an element, and other metadata needed to keep track of the
+ * tree structure.
+ */
+typedef struct __fibTreeNode {
+    FibKey key;                      // Key, stored inline.
+    void *elem;                      // Element stored in the node.
+    struct __fibTreeNode *_father;   // Pointer to the father node, if present.
+    struct __fibTreeNode *_firstSon; // Pointer to the first son, if present.
+    struct __fibTreeNode *_nextBro;  // Pointer to the next brother, if present.
+    struct __fibTreeNode *_prevBro;  // Pointer to the previous brother.
+    Record *_posInForest;            // For roots, position in a forest list.
+    uint32_t _sonsCnt;               // Counter for a node' sons.
+    unsigned char _grief;            // Indicates the loss of a son.
+} FibTreeNode;
+
+/* Fibonacci Tree. Stores a pointer to its root node. */
+typedef struct {
+    FibTreeNode *_root;
+} FibTree;
+
+/* Fibonacci Heap. Keeps a pointer to its minimum-key node (and some
+ * metadata to better track it). The "forest" is seen as an array of dynamic
+ * lists, which contain pointers to trees of a specific order.
+ */
+typedef struct {
+    DLList **_forest;         // Array of lists for different tree sizes.
+    FibTreeNode *min;         // Pointer to minimum key node.
+    ulong _maxTreeOrd;        // Maximum size for a tree (changes if needed).
+    ulong nodesCount;         // Counter for the nodes in the structure.
+} FibHeap;
+
+/* Compares two keys lexicographically.
+ * Returns a negative value if the first one is smaller, a positive value if
+ * it is greater, 0 if they are equal.
+ */
+static inline int fhKeyCmp(const FibKey *key, const FibKey *otherKey) {
+    for (int i = 0; i < FH_KEY_FIELDS; i++)
+        if (key->fields[i] != otherKey->fields[i])
+            return key->fields[i] < otherKey->fields[i] ? -1 : 1;
+    return 0;
+}
+
+/* Tells whether a key is smaller than another one. */
+static inline int fhKeyLess(const FibKey *key, const FibKey *otherKey) {
+    return fhKeyCmp(key, otherKey) < 0;
+}
+
+/* Library functions. */
+FibHeap *createFibHeap(ulong initMaxTreeOrd);
+void eraseFibHeap(FibHeap *heap, int opts);
+void eraseFibTreeNode(FibTreeNode *node, int opts);
+int isHeapEmpty(FibHeap *heap);
+FibTreeNode *fhInsert(FibHeap *heap, void *elem, FibKey key);
+void *fhFindMin(FibHeap *heap);
+FibTreeNode *fhDecreaseKey(FibHeap *heap, FibTreeNode *node, FibKey newKey);
+FibTreeNode *fhDeleteMin(FibHeap *heap);
+FibTreeNode *fhDelete(FibHeap *heap, FibTreeNode *node);
+FibTreeNode *fhIncreaseKey(FibHeap *heap, FibTreeNode *node, FibKey newKey);
+
+#endif
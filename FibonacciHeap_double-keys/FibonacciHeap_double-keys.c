@@ -0,0 +1,57 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Fibonacci Heap double keys library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <math.h>
+
+#include "FibonacciHeap_double-keys.h"
+
+// LIBRARY FUNCTIONS //
+/* Creates a new node with a double key and adds it to the heap.
+ * Returns NULL if the key is NaN.
+ */
+FibTreeNode *fhdInsert(FibHeap *heap, void *elem, double key) {
+    if (isnan(key)) return NULL;
+    return fhInsert(heap, elem, fhdToBits(key));
+}
+
+/* Returns the key of a node. */
+double fhdKey(FibTreeNode *node) {
+    if (node == NULL) return NAN;
+    return fhdFromBits(node->key);
+}
+
+/* Returns the minimum key in the heap, or NaN if it is empty. */
+double fhdMinKey(FibHeap *heap) {
+    if ((heap == NULL) || (heap->min == NULL)) return NAN;
+    return fhdFromBits(heap->min->key);
+}
+
+/* Decreases node's key to newKey, updating the heap structure.
+ * Returns a pointer to the node, or NULL if newKey is NaN or greater than its
+ * key.
+ */
+FibTreeNode *fhdDecreaseKey(FibHeap *heap, FibTreeNode *node, double newKey) {
+    if ((heap == NULL) || (node == NULL) || isnan(newKey)) return NULL;
+    uint64_t newBits = fhdToBits(newKey);
+    if (newBits > node->key) return NULL;
+    return fhDecreaseKey(heap, node, node->key - newBits);
+}
+
+/* Increases node's key to newKey, updating the heap structure.
+ * Returns a pointer to the node, or NULL if newKey is NaN or smaller than its
+ * key.
+ */
+FibTreeNode *fhdIncreaseKey(FibHeap *heap, FibTreeNode *node, double newKey) {
+    if ((heap == NULL) || (node == NULL) || isnan(newKey)) return NULL;
+    uint64_t newBits = fhdToBits(newKey);
+    if (newBits < node->key) return NULL;
+    return fhIncreaseKey(heap, node, newBits - node->key);
+}
@@ -0,0 +1,60 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains declarations for the Fibonacci Heap double keys library,
+ * which lets the uint64 keys Fibonacci Heap be used with double precision
+ * floating-point keys. Keys are mapped to integers with an order-preserving
+ * bit transform (the sign bit of positive numbers is set, all bits of
+ * negative ones are flipped), so the heap itself only ever compares integers.
+ * The heap and its nodes are the usual ones: these functions only convert keys
+ * where they go in or out, and all other operations (deletions, pools,
+ * indexes...) can be used on the same heap as they are.
+ * Keys are ordered as follows:
+ * -inf < negative numbers < -0.0 < +0.0 < positive numbers < +inf,
+ * and the transform is exact, so the key of a node always reads back as the
+ * very same double that was stored, including the sign of zero.
+ * NOTE: NaN keys are rejected, i.e. the operations that get one fail, so
+ * there is never a NaN in a heap.
+ * NOTE: Key modifications take the new key instead of a difference, and fail
+ * if it goes the wrong way.
+ * WARNING: Node keys hold the transformed bits: use "fhdKey" to read them.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef FIBONACCIHEAP_DOUBLE_KEYS_H
+#define FIBONACCIHEAP_DOUBLE_KEYS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Sign bit of a double. */
+#define FHD_SIGN_BIT (1ULL << 63)
+
+/* Maps a double to an integer key with the same order. */
+static inline uint64_t fhdToBits(double key) {
+    uint64_t bits;
+    memcpy(&bits, &key, sizeof(uint64_t));
+    return (bits & FHD_SIGN_BIT) ? ~bits : (bits | FHD_SIGN_BIT);
+}
+
+/* Maps an integer key back to its double. */
+static inline double fhdFromBits(uint64_t bits) {
+    double key;
+    bits = (bits & FHD_SIGN_BIT) ? (bits & ~FHD_SIGN_BIT) : ~bits;
+    memcpy(&key, &bits, sizeof(double));
+    return key;
+}
+
+/* Library functions. */
+FibTreeNode *fhdInsert(FibHeap *heap, void *elem, double key);
+double fhdKey(FibTreeNode *node);
+double fhdMinKey(FibHeap *heap);
+FibTreeNode *fhdDecreaseKey(FibHeap *heap, FibTreeNode *node, double newKey);
+FibTreeNode *fhdIncreaseKey(FibHeap *heap, FibTreeNode *node, double newKey);
+
+#endif
@@ -11,19 +11,87 @@
 
 #include <stdlib.h>
 #include <limits.h>
+#include <pthread.h>
 
 #include "FibonacciHeap_uint64-keys.h"
 
+/* Size of tables of trees by order: a tree of order d has at least F(d + 2)
+ * nodes (F being Fibonacci numbers), so d is below 1.45 * log2(nodes).
+ */
+#define FH_ORD_TABLE_SIZE (sizeof(ulong) * 16)
+
+/* State of a node targeted by a batch of operations. */
+typedef struct {
+    FibTreeNode *node;               // NULL for empty entries.
+    uint64_t key;                    // Key after the operations so far.
+    ulong lastOp;                    // Last operation (ULONG_MAX if none).
+    int deleted;
+} FibBatchEntry;
+
+/* Slice of roots linked by a thread in a parallel consolidation. */
+typedef struct {
+    FibTreeNode **roots;
+    ulong rootsCnt;
+    FibTreeNode *table[FH_ORD_TABLE_SIZE];   // Trees by order.
+} FibRebuildSlice;
+
 /* Declarations of internal library subroutines. */
 Record *_mergeRecordedTrees(FibTree *tree, FibTree *otherTree,
                             Record *firstTreeRecord, Record *otherTreeRecord);
 void _cutSubtrees(FibTree *tree);
 void _updateMin(FibHeap *heap, FibTreeNode *newNode);
 void _rebuild(FibHeap *heap);
+int _parallelRebuild(FibHeap *heap);
+DLList *_reserveRebuild(FibHeap *heap, ulong rootsCnt);
+void _consolidate(FibHeap *heap, FibTreeNode **roots, ulong rootsCnt,
+                  ulong threadsCnt, DLList *spares);
+void *_linkSlice(void *arg);
+void _tableAdd(FibTreeNode **table, FibTreeNode *root);
 FibTreeNode *_insertNode(FibHeap *heap, FibTreeNode *node);
 void _eraseTree(FibTree *tree, int opts);
-void _eraseSubtree(FibTreeNode *root, int opts);
-void _cascadedDetach(FibHeap *heap, FibTreeNode *decNode);
+ulong _eraseSubtree(FibTreeNode *root, int opts);
+void _cascadedDetach(FibHeap *heap, FibTreeNode *decNode, DLList *spares);
+void _sonLost(FibHeap *heap, FibTreeNode *father, DLList *spares);
+void _unlinkSon(FibHeap *heap, FibTreeNode *son, DLList *spares);
+int _plantTree(FibHeap *heap, FibTreeNode *root);
+void _dropNode(FibHeap *heap, FibTreeNode *node, DLList *spares, int opts);
+void _cutNode(FibHeap *heap, FibTreeNode *node, DLList *spares);
+FibBatchEntry *_batchEntry(FibBatchEntry *table, ulong size,
+                           FibTreeNode *node);
+int _batchUpdate(FibOp *op, uint64_t *key);
+int _mustPrune(uint64_t key, uint64_t threshold, ulong *ties);
+ulong _countCuts(FibTreeNode *root, uint64_t threshold);
+FibTreeNode **_listRoots(FibHeap *heap, ulong *rootsCnt);
+ulong _pruneSubtree(FibHeap *heap, FibTreeNode *root, uint64_t threshold,
+                    ulong *ties, DLList *spares, int opts);
+ulong _pruneTree(FibHeap *heap, FibTreeNode *root, uint64_t threshold,
+                 ulong *ties, DLList *spares, int opts);
+void _collectKeys(FibTreeNode *root, uint64_t *keys, ulong *pos);
+uint64_t _selectKey(uint64_t *keys, ulong n, ulong k);
+FibTreeNode *_newNode(FibHeap *heap);
+FibTreeNode *_newChunkNode(FibNodePool *pool);
+ulong *_radixOrder(uint64_t *keys, ulong n);
+ulong _smallestNodes(FibHeap *heap, ulong n, FibTreeNode **nodes,
+                     FibTreeNode ***frontier, ulong *frontierCnt);
+void _siftUpNode(FibTreeNode **nodes, ulong pos);
+void _siftDownNode(FibTreeNode **nodes, ulong cnt, ulong pos);
+void _freeNode(FibTreeNode *node);
+uint64_t _hashId(uint64_t id);
+int _transformSubtree(FibTreeNode *root,
+                      uint64_t (*fn)(uint64_t key, void *ctx), void *ctx);
+FibTreeNode *_linkRoots(FibTreeNode *root, FibTreeNode *otherRoot);
+int _growForest(FibHeap *heap, ulong treeOrd);
+ulong _maxOrder(ulong nodesCnt);
+int _reserveTrees(DLList *spares, ulong cnt);
+void _takeForest(FibHeap *heap, DLList *spares);
+void _plantSpareTree(FibHeap *heap, DLList *spares, FibTreeNode *root);
+void _eraseSpareTrees(DLList *spares);
+void _relaxedUpdateMin(FibHeap *heap, FibTreeNode *deleted);
+void _relaxedFillCands(FibHeap *heap);
+void _relaxedDropCand(FibHeap *heap, FibTreeNode *node);
+FibIndexEntry *_findEntry(FibHeap *heap, uint64_t id);
+void _removeEntry(FibIndex *index, FibIndexEntry *entry);
+int _resizeIndex(FibHeap *heap, ulong newSize);
 
 // LIBRARY FUNCTIONS //
 /* Creates and initializes a new Fibonacci Heap.
@@ -57,6 +125,29 @@ FibHeap *createFibHeap(ulong initMaxTreeOrd) {
     newHeap->min = NULL;
     newHeap->_maxTreeOrd = initMaxTreeOrd;
     newHeap->nodesCount = 0;
+    newHeap->_pool = NULL;
+    newHeap->_index = NULL;
+    newHeap->_relaxRoots = 0;
+    newHeap->_relaxEps = 0;
+    newHeap->_lowBound = UINT64_MAX;
+    newHeap->_relaxCands = NULL;
+    newHeap->_relaxCandsCnt = 0;
+    newHeap->_rebuildThreads = 1;
+    newHeap->_rebuildMinRoots = FH_PARALLEL_MIN_ROOTS;
+    return newHeap;
+}
+
+/* Creates and initializes a new Fibonacci Heap which takes its nodes from a
+ * pool, and supports handles (see the header file).
+ */
+FibHeap *createPooledFibHeap(ulong initMaxTreeOrd) {
+    FibHeap *newHeap = createFibHeap(initMaxTreeOrd);
+    if (newHeap == NULL) return NULL;
+    newHeap->_pool = calloc(1, sizeof(FibNodePool));
+    if (newHeap->_pool == NULL) {
+        eraseFibHeap(newHeap, 0);
+        return NULL;
+    }
     return newHeap;
 }
 
@@ -76,14 +167,26 @@ void eraseFibHeap(FibHeap *heap, int opts) {
             eraseList((heap->_forest)[i]);
     }
     free(heap->_forest);
+    if (heap->_pool != NULL) {
+        for (ulong i = 0; i < heap->_pool->_chunksCnt; i++)
+            free((heap->_pool->_chunks)[i]);
+        free(heap->_pool->_chunks);
+        free(heap->_pool);
+    }
+    if (heap->_index != NULL) {
+        free(heap->_index->_handles);
+        free(heap->_index->_entries);
+        free(heap->_index);
+    }
+    free(heap->_relaxCands);
     free(heap);
 }
 
-/* Deletes a given node, freeing memory. */
+/* Deletes a given node, freeing memory (or giving it back to its pool). */
 void eraseFibTreeNode(FibTreeNode *node, int opts) {
     if (node == NULL) return;
     if (opts & DELETE_FREE_DATA) free(node->elem);
-    free(node);
+    _freeNode(node);
 }
 
 /* Tells whether a given heap is empty or not. */
@@ -101,12 +204,76 @@ void *fhFindMin(FibHeap *heap) {
     return heap->min->elem;
 }
 
+/* Copies the n smallest keys in the heap, in ascending order, and their
+ * elements (either array can be NULL), without modifying it.
+ * Returns the number of keys copied (fewer than n if the heap has fewer
+ * nodes, or on failure).
+ */
+ulong fhPeekSmallest(FibHeap *heap, ulong n, uint64_t *keys, void **elems) {
+    if ((heap == NULL) || (n == 0) || (heap->min == NULL)) return 0;
+    if (n > heap->nodesCount) n = heap->nodesCount;
+    FibTreeNode **nodes = calloc(n, sizeof(FibTreeNode *));
+    if (nodes == NULL) return 0;
+    ulong found = _smallestNodes(heap, n, nodes, NULL, NULL);
+    for (ulong i = 0; i < found; i++) {
+        if (keys != NULL) keys[i] = nodes[i]->key;
+        if (elems != NULL) elems[i] = nodes[i]->elem;
+    }
+    free(nodes);
+    return found;
+}
+
+/* Deletes the p nodes with the smallest keys from the heap, storing them in
+ * ascending order of key. Such nodes are found in one visit of the trees,
+ * whose final frontier holds the new roots: these are linked at once (on
+ * multiple threads if they are enough, see "fhSetParallelRebuild"), with a
+ * single consolidation for the whole batch.
+ * Returns the number of deleted nodes (fewer than p if the heap has fewer
+ * nodes, or on failure).
+ */
+ulong fhDeleteMinBatch(FibHeap *heap, ulong p, FibTreeNode **nodes) {
+    if ((heap == NULL) || (nodes == NULL) || (p == 0)) return 0;
+    if (heap->min == NULL) return 0;
+    FibTreeNode **roots = NULL;
+    ulong rootsCnt = 0;
+    ulong found = _smallestNodes(heap, p, nodes, &roots, &rootsCnt);
+    DLList *spares = found > 0 ? _reserveRebuild(heap, rootsCnt) : NULL;
+    if (spares == NULL) {
+        free(roots);
+        return 0;
+    }
+
+    // Detach the new roots from their old fathers.
+    for (ulong i = 0; i < rootsCnt; i++) {
+        roots[i]->_father = NULL;
+        roots[i]->_nextBro = NULL;
+        roots[i]->_prevBro = NULL;
+        roots[i]->_grief = 0;
+    }
+    for (ulong i = 0; i < found; i++) {
+        nodes[i]->_father = NULL;
+        nodes[i]->_firstSon = NULL;
+        nodes[i]->_nextBro = NULL;
+        nodes[i]->_prevBro = NULL;
+        nodes[i]->_posInForest = NULL;
+        nodes[i]->_sonsCnt = 0;
+        nodes[i]->_grief = 0;
+    }
+    heap->nodesCount -= found;
+    heap->min = NULL;
+    _consolidate(heap, roots, rootsCnt, rootsCnt >= heap->_rebuildMinRoots ?
+                                        heap->_rebuildThreads : 1, spares);
+    free(roots);
+    _updateMin(heap, NULL);
+    return found;
+}
+
 /* Creates a new node, as a B0 tree, and adds it to the heap. */
 FibTreeNode *fhInsert(FibHeap *heap, void *elem, uint64_t key) {
     if (heap == NULL) return NULL;
     if (heap->nodesCount == ULONG_MAX) return NULL;  // The heap is full.
     // Create a new node.
-    FibTreeNode *newNode = calloc(1, sizeof(FibTreeNode));
+    FibTreeNode *newNode = _newNode(heap);
     if (newNode == NULL) return NULL;
     newNode->key = key;
     newNode->elem = elem;
@@ -120,6 +287,401 @@ FibTreeNode *fhInsert(FibHeap *heap, void *elem, uint64_t key) {
     return _insertNode(heap, newNode);
 }
 
+/* Adds an existing node, which must not be in a heap, with a given key.
+ * Meant to reuse nodes, or to use nodes allocated by the caller (which must
+ * then be kept by the delete functions, see DELETE_KEEP_NODES).
+ * Returns a pointer to the node.
+ */
+FibTreeNode *fhInsertNode(FibHeap *heap, FibTreeNode *node, uint64_t key) {
+    if ((heap == NULL) || (node == NULL)) return NULL;
+    if (heap->nodesCount == ULONG_MAX) return NULL;  // The heap is full.
+    if (node->_pool != NULL) {
+        // A pooled node coming back is a new element: its old handles (and
+        // index entries) must not refer to it anymore.
+        node->_gen++;
+        if (node->_gen == 0) node->_gen = 1;  // Keep handles nonzero.
+    }
+    node->key = key;
+    node->_father = NULL;
+    node->_firstSon = NULL;
+    node->_nextBro = NULL;
+    node->_prevBro = NULL;
+    node->_sonsCnt = 0;
+    node->_grief = 0;
+    if (!_plantTree(heap, node)) return NULL;
+    _updateMin(heap, node);
+    heap->nodesCount++;
+    return node;
+}
+
+/* Removes all nodes from a heap, which stays ready to be used.
+ * Takes time proportional to the number of nodes left in the heap.
+ */
+void fhClear(FibHeap *heap, int opts) {
+    if (heap == NULL) return;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++) {
+        while (!isListEmpty((heap->_forest)[i])) {
+            FibTree *currTree = popFirst((heap->_forest)[i]);
+            _eraseTree(currTree, opts);
+        }
+    }
+    heap->min = NULL;
+    heap->nodesCount = 0;
+    heap->_lowBound = UINT64_MAX;
+    heap->_relaxCandsCnt = 0;
+}
+
+/* Adds n elements to a heap, given their keys in ascending order (elems can
+ * be NULL, for NULL elements). Consecutive runs of 2^k keys become binomial
+ * trees of order k, whose first key is the root, so the heap is built in
+ * linear time. Unless BUILD_TRUST_SORTED is passed, the order of the keys is
+ * checked first, and keys that turn out not to be sorted are radix sorted.
+ * Returns 0 on success, -1 on failure (the heap is left as it was then).
+ */
+int fhBuildFromSorted(FibHeap *heap, uint64_t *keys, void **elems, ulong n,
+                      int opts) {
+    if ((heap == NULL) || ((keys == NULL) && (n > 0))) return -1;
+    if (n == 0) return 0;
+    if (n > ULONG_MAX - heap->nodesCount) return -1;  // The heap is full.
+
+    // Check the order of the keys, and sort them if needed.
+    ulong *order = NULL;
+    if (!(opts & BUILD_TRUST_SORTED)) {
+        for (ulong i = 1; i < n; i++) {
+            if (keys[i] < keys[i - 1]) {
+                order = _radixOrder(keys, n);
+                if (order == NULL) return -1;
+                break;
+            }
+        }
+    }
+
+    // Get all nodes and trees first, so that nothing has to be undone in the
+    // heap.
+    ulong maxOrd = (sizeof(ulong) * 8) - 1 - (ulong)__builtin_clzl(n);
+    FibTreeNode **nodes = calloc(n, sizeof(FibTreeNode *));
+    DLList *spares = createDLList();
+    if ((nodes == NULL) || (spares == NULL) ||
+        (_growForest(heap, maxOrd) != 0) ||
+        (_reserveTrees(spares, (ulong)__builtin_popcountl(n)) != 0)) {
+        free(nodes);
+        free(order);
+        _eraseSpareTrees(spares);
+        return -1;
+    }
+    for (ulong i = 0; i < n; i++) {
+        nodes[i] = heap->_pool != NULL ? _newChunkNode(heap->_pool) :
+                                         calloc(1, sizeof(FibTreeNode));
+        if (nodes[i] == NULL) {
+            for (ulong j = 0; j < i; j++) _freeNode(nodes[j]);
+            free(nodes);
+            free(order);
+            _eraseSpareTrees(spares);
+            return -1;
+        }
+    }
+
+    // Split the keys in runs of decreasing powers of 2, as the bits of n.
+    // In a run, the node at offset i has sons at offsets i + 2^j, for each j
+    // below the lowest set bit of i (or the run's order, for the root), so
+    // each subtree is a contiguous range of the run.
+    ulong base = 0;
+    for (ulong ord = maxOrd + 1; ord-- > 0;) {
+        ulong runSize = 1UL << ord;
+        if (!(n & runSize)) continue;
+        for (ulong i = 0; i < runSize; i++) {
+            ulong src = order != NULL ? order[base + i] : base + i;
+            FibTreeNode *node = nodes[base + i];
+            node->key = keys[src];
+            node->elem = elems != NULL ? elems[src] : NULL;
+            node->_father = NULL;
+            node->_firstSon = NULL;
+            node->_nextBro = NULL;
+            node->_prevBro = NULL;
+            node->_posInForest = NULL;
+            node->_sonsCnt = 0;
+            node->_grief = 0;
+            if (i == 0) continue;
+            // Sons are added in increasing order, so the first son is the
+            // one with the largest subtree, as after a link.
+            FibTreeNode *father = nodes[base + i - (i & -i)];
+            node->_father = father;
+            node->_nextBro = father->_firstSon;
+            if (father->_firstSon != NULL) father->_firstSon->_prevBro = node;
+            father->_firstSon = node;
+            father->_sonsCnt++;
+        }
+        _plantSpareTree(heap, spares, nodes[base]);
+        _updateMin(heap, nodes[base]);
+        base += runSize;
+    }
+    heap->nodesCount += n;
+    free(nodes);
+    free(order);
+    _eraseSpareTrees(spares);
+    return 0;
+}
+
+/* Returns a handle to a pooled node, or FH_NULL_HANDLE if the node doesn't
+ * come from a pool.
+ */
+FibHandle fhHandle(FibTreeNode *node) {
+    if ((node == NULL) || (node->_pool == NULL)) return FH_NULL_HANDLE;
+    return ((FibHandle)(node->_gen) << 32) | node->_poolIdx;
+}
+
+/* Returns the node referred to by a handle, or NULL if the handle is stale,
+ * i.e. its node has been erased or is not in the heap anymore.
+ */
+FibTreeNode *fhResolve(FibHeap *heap, FibHandle handle) {
+    if ((heap == NULL) || (heap->_pool == NULL)) return NULL;
+    ulong idx = handle & UINT32_MAX;
+    uint32_t gen = (uint32_t)(handle >> 32);
+    if (idx >= heap->_pool->_used) return NULL;
+    FibTreeNode *node = &((heap->_pool->_chunks)[idx >> FH_POOL_CHUNK_ORD]
+                          [idx & ((1UL << FH_POOL_CHUNK_ORD) - 1)]);
+    if (node->_gen != gen) return NULL;
+    // Nodes in the heap are either roots (with a position in the forest) or
+    // have a father.
+    if ((node->_father == NULL) && (node->_posInForest == NULL)) return NULL;
+    return node;
+}
+
+/* Enables the element ID index of a pooled heap, which must be empty.
+ * If denseIds is not 0, IDs must be in [0, denseIds), and are direct-mapped;
+ * otherwise, IDs can be any 64-bit value, and are hashed.
+ * Returns 0 on success, -1 on failure.
+ */
+int fhEnableIndex(FibHeap *heap, ulong denseIds) {
+    if ((heap == NULL) || (heap->_pool == NULL) || (heap->_index != NULL))
+        return -1;
+    if (heap->nodesCount != 0) return -1;
+    FibIndex *newIndex = calloc(1, sizeof(FibIndex));
+    if (newIndex == NULL) return -1;
+    if (denseIds > 0) {
+        newIndex->_handles = calloc(denseIds, sizeof(FibHandle));
+        newIndex->_size = denseIds;
+    } else {
+        newIndex->_entries = calloc(FH_INDEX_INIT_SIZE, sizeof(FibIndexEntry));
+        newIndex->_size = FH_INDEX_INIT_SIZE;
+    }
+    if ((newIndex->_handles == NULL) && (newIndex->_entries == NULL)) {
+        free(newIndex);
+        return -1;
+    }
+    heap->_index = newIndex;
+    return 0;
+}
+
+/* Creates a new node with an element and its ID, and adds it to the heap.
+ * Fails if an element with the same ID is already in the heap.
+ */
+FibTreeNode *fhInsertWithId(FibHeap *heap, void *elem, uint64_t key,
+                            uint64_t id) {
+    if ((heap == NULL) || (heap->_index == NULL)) return NULL;
+    FibIndex *index = heap->_index;
+    if (index->_handles != NULL) {
+        if (id >= index->_size) return NULL;
+        if (fhResolve(heap, (index->_handles)[id]) != NULL) return NULL;
+        FibTreeNode *newNode = fhInsert(heap, elem, key);
+        if (newNode == NULL) return NULL;
+        (index->_handles)[id] = fhHandle(newNode);
+        return newNode;
+    }
+
+    // Sparse IDs: look for the ID first (purging it if stale).
+    if (_findEntry(heap, id) != NULL) return NULL;
+    if ((index->_used + 1) > ((index->_size / 4) * 3)) {
+        // Grow the table only if it's still crowded without stale entries.
+        ulong newSize = index->_size;
+        if ((heap->nodesCount + 1) > (index->_size / 2)) newSize *= 2;
+        if (_resizeIndex(heap, newSize) != 0) return NULL;
+    }
+    FibTreeNode *newNode = fhInsert(heap, elem, key);
+    if (newNode == NULL) return NULL;
+    ulong mask = index->_size - 1;
+    ulong pos = _hashId(id) & mask;
+    while ((index->_entries)[pos].handle != FH_NULL_HANDLE)
+        pos = (pos + 1) & mask;
+    (index->_entries)[pos].id = id;
+    (index->_entries)[pos].handle = fhHandle(newNode);
+    index->_used++;
+    return newNode;
+}
+
+/* Returns the node of the element with a given ID, or NULL if it is not in
+ * the heap.
+ */
+FibTreeNode *fhFindById(FibHeap *heap, uint64_t id) {
+    if ((heap == NULL) || (heap->_index == NULL)) return NULL;
+    FibIndex *index = heap->_index;
+    if (index->_handles != NULL) {
+        if (id >= index->_size) return NULL;
+        return fhResolve(heap, (index->_handles)[id]);
+    }
+    FibIndexEntry *entry = _findEntry(heap, id);
+    return entry != NULL ? fhResolve(heap, entry->handle) : NULL;
+}
+
+/* Tells whether the element with a given ID is in the heap. */
+int fhContains(FibHeap *heap, uint64_t id) {
+    if ((heap == NULL) || (heap->_index == NULL)) return -1;
+    return fhFindById(heap, id) != NULL;
+}
+
+/* Decreases the key of the element with a given ID of dec.
+ * Returns a pointer to its node, or NULL if it is not in the heap.
+ */
+FibTreeNode *fhDecreaseKeyById(FibHeap *heap, uint64_t id, uint64_t dec) {
+    return fhDecreaseKey(heap, fhFindById(heap, id), dec);
+}
+
+/* Deletes the element with a given ID from the heap, and returns its node
+ * (or NULL if it is not in the heap).
+ */
+FibTreeNode *fhDeleteById(FibHeap *heap, uint64_t id) {
+    if ((heap == NULL) || (heap->_index == NULL)) return NULL;
+    FibIndex *index = heap->_index;
+    FibTreeNode *node;
+    if (index->_handles != NULL) {
+        if (id >= index->_size) return NULL;
+        node = fhResolve(heap, (index->_handles)[id]);
+        if (node == NULL) return NULL;
+        (index->_handles)[id] = FH_NULL_HANDLE;
+    } else {
+        FibIndexEntry *entry = _findEntry(heap, id);
+        if (entry == NULL) return NULL;
+        node = fhResolve(heap, entry->handle);
+        _removeEntry(index, entry);
+    }
+    return fhDelete(heap, node);
+}
+
+/* Replaces the key of each node with fn(key, ctx).
+ * If the heap order still holds afterwards (as it does if fn is monotone), the
+ * structure is left as it is. Otherwise, the heap is rebuilt in a single pass
+ * over its nodes, as a set of trees of distinct orders.
+ * Returns 0 if the structure was kept, 1 if it was rebuilt, -1 on failure (in
+ * which case no key is changed).
+ */
+int fhTransformKeys(FibHeap *heap, uint64_t (*fn)(uint64_t key, void *ctx),
+                    void *ctx) {
+    if ((heap == NULL) || (fn == NULL)) return -1;
+    if (heap->nodesCount == 0) return 0;
+
+    // Get what a rebuild would need first, so that it can't fail halfway: the
+    // lists for the orders of its trees, and a tree for each of them (those
+    // in the forest are recycled, so new ones are seldom needed).
+    ulong maxOrd = (sizeof(ulong) * 8) - 1 -
+                   (ulong)__builtin_clzl(heap->nodesCount);
+    ulong newTreesCnt = (ulong)__builtin_popcountl(heap->nodesCount);
+    ulong treesCnt = 0;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++)
+        treesCnt += (heap->_forest)[i]->recsCount;
+    DLList *spares = createDLList();
+    if ((spares == NULL) || (_growForest(heap, maxOrd) != 0) ||
+        ((newTreesCnt > treesCnt) &&
+         (_reserveTrees(spares, newTreesCnt - treesCnt) != 0))) {
+        _eraseSpareTrees(spares);
+        return -1;
+    }
+
+    // Transform all keys, checking the heap order along the way.
+    int ordered = 1;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++) {
+        Record *curr = (heap->_forest)[i]->first;
+        while (curr != NULL) {
+            FibTreeNode *root = ((FibTree *)(curr->recData))->_root;
+            root->key = fn(root->key, ctx);
+            ordered &= _transformSubtree(root, fn, ctx);
+            curr = curr->next;
+        }
+    }
+    if (ordered) {
+        _eraseSpareTrees(spares);
+        _updateMin(heap, NULL);
+        return 0;
+    }
+
+    // Take all trees out, and link all nodes back pairwise, as in a binary
+    // counter: only the final roots need trees. Nodes yet to be linked are
+    // stacked through their brother pointers.
+    FibTreeNode *roots[(sizeof(ulong) * 8) + 1] = {NULL};
+    FibTreeNode *stack = NULL;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++) {
+        Record *curr = (heap->_forest)[i]->first;
+        while (curr != NULL) {
+            FibTreeNode *root = ((FibTree *)(curr->recData))->_root;
+            root->_nextBro = stack;
+            stack = root;
+            curr = curr->next;
+        }
+    }
+    _takeForest(heap, spares);
+    while (stack != NULL) {
+        FibTreeNode *carry = stack;
+        stack = carry->_nextBro;
+        FibTreeNode *currSon = carry->_firstSon;
+        while (currSon != NULL) {
+            FibTreeNode *nextOne = currSon->_nextBro;
+            currSon->_nextBro = stack;
+            stack = currSon;
+            currSon = nextOne;
+        }
+        carry->_father = NULL;
+        carry->_firstSon = NULL;
+        carry->_nextBro = NULL;
+        carry->_prevBro = NULL;
+        carry->_posInForest = NULL;
+        carry->_sonsCnt = 0;
+        carry->_grief = 0;
+        ulong ord = 0;
+        while (roots[ord] != NULL) {
+            carry = _linkRoots(roots[ord], carry);
+            roots[ord++] = NULL;
+        }
+        roots[ord] = carry;
+    }
+    for (ulong ord = 0; ord <= maxOrd; ord++)
+        if (roots[ord] != NULL) _plantSpareTree(heap, spares, roots[ord]);
+    _eraseSpareTrees(spares);
+    _updateMin(heap, NULL);
+    return 1;
+}
+
+/* Switches a heap to relaxed mode (see the header file), in which trees are
+ * consolidated only when there are more than maxRoots, and the minimum may
+ * have a key up to eps greater than the smallest one. A maxRoots of 0
+ * switches the heap back to exact mode.
+ * Returns 0 on success, -1 on failure.
+ */
+int fhSetRelaxed(FibHeap *heap, ulong maxRoots, uint64_t eps) {
+    if (heap == NULL) return -1;
+    if ((maxRoots > 0) && (heap->_relaxCands == NULL)) {
+        heap->_relaxCands = calloc(FH_RELAX_CANDS, sizeof(FibTreeNode *));
+        if (heap->_relaxCands == NULL) return -1;
+    }
+    heap->_relaxRoots = maxRoots;
+    heap->_relaxEps = maxRoots > 0 ? eps : 0;
+    heap->_relaxCandsCnt = 0;
+    // Switching back, the heap must be brought to an exact state.
+    if (maxRoots == 0) _rebuild(heap);
+    else _updateMin(heap, NULL);
+    return 0;
+}
+
+/* Makes consolidations of at least minRoots roots (FH_PARALLEL_MIN_ROOTS if
+ * 0) run on a given number of threads, the calling one included. A single
+ * thread makes them all serial again.
+ * Returns 0 on success, -1 on failure.
+ */
+int fhSetParallelRebuild(FibHeap *heap, ulong threadsCnt, ulong minRoots) {
+    if ((heap == NULL) || (threadsCnt == 0)) return -1;
+    heap->_rebuildThreads = threadsCnt;
+    heap->_rebuildMinRoots = minRoots > 0 ? minRoots : FH_PARALLEL_MIN_ROOTS;
+    return 0;
+}
+
 /* Decreases node's key of dec (key -= dec), updating the heap structure.
  * Returns a pointer to the node.
  */
@@ -130,7 +692,7 @@ FibTreeNode *fhDecreaseKey(FibHeap *heap, FibTreeNode *node, uint64_t dec) {
     // preserve the Fibonacci Tree structure.
     node->key -= dec;
     if ((node->_father != NULL) && (node->key < node->_father->key))
-        _cascadedDetach(heap, node);
+        _cascadedDetach(heap, node, NULL);
 
     // Check if the node is now a root.
     if (node->_father == NULL)
@@ -182,7 +744,8 @@ FibTreeNode *fhDeleteMin(FibHeap *heap) {
         newRoot = nextOne;
     }
 
-    _rebuild(heap);
+    if (heap->_relaxRoots == 0) _rebuild(heap);
+    else _relaxedUpdateMin(heap, minNode);
     heap->nodesCount--;
 
     minNode->_father = NULL;
@@ -202,8 +765,12 @@ FibTreeNode *fhDelete(FibHeap *heap, FibTreeNode *node) {
     // Save key value.
     uint64_t key = node->key;
 
-    // Decrease key value to min.
-    fhDecreaseKey(heap, node, node->key);
+    // Decrease key value to min, making the node a root. Other nodes could
+    // have a null key too, so it must be cut even from a father with the
+    // same key, and forced as the min.
+    node->key = 0;
+    if (node->_father != NULL) _cascadedDetach(heap, node, NULL);
+    heap->min = node;
 
     // Delete the node with min key in heap; it will be the node to be deleted.
     FibTreeNode *deleted = fhDeleteMin(heap);
@@ -215,17 +782,256 @@ FibTreeNode *fhDelete(FibHeap *heap, FibTreeNode *node) {
 }
 
 /* Increases node key of inc (key += inc), updating the heap structure.
- * Returns a pointer to the node.
+ * Returns a pointer to the node, or NULL on failure (in which case the node
+ * is left as it was).
  */
 FibTreeNode *fhIncreaseKey(FibHeap *heap, FibTreeNode *node, uint64_t inc) {
     if ((heap == NULL) || (node == NULL)) return NULL;
 
-    // Delete the node from the heap and re-insert it with the new key.
-    FibTreeNode *deletedNode = fhDelete(heap, node);
-    deletedNode->key += inc;
-    _insertNode(heap, deletedNode);
+    // Sons of the node become roots, and so does the node: all the trees
+    // they need are taken first, so that nothing can be lost.
+    DLList *spares = createDLList();
+    if ((spares == NULL) ||
+        (_reserveTrees(spares, node->_sonsCnt + 1) != 0)) {
+        _eraseSpareTrees(spares);
+        return NULL;
+    }
+
+    // Cut the node from the heap and put it back alone, with the new key.
+    _cutNode(heap, node, spares);
+    node->_father = NULL;
+    node->_nextBro = NULL;
+    node->_prevBro = NULL;
+    node->key += inc;
+    _plantSpareTree(heap, spares, node);
+    _eraseSpareTrees(spares);
+
+    // Trees are consolidated as after a deletion, but in relaxed mode the
+    // minimum changes only if it was this node.
+    if (heap->_relaxRoots == 0) _rebuild(heap);
+    else if (heap->min == NULL) _relaxedUpdateMin(heap, NULL);
+    return node;
+}
+
+/* Deletes all nodes with key strictly greater than threshold, freeing memory.
+ * Whole subtrees above the threshold are dropped at once, while the nodes
+ * that lose sons are handled as in a key decrease (cascading cuts).
+ * Returns the number of deleted nodes (0 on failure, in which case the heap
+ * is left as it was).
+ */
+ulong fhDeleteAbove(FibHeap *heap, uint64_t threshold, int opts) {
+    if (heap == NULL) return 0;
+    if ((heap->min == NULL) || (heap->nodesCount == 0)) return 0;
+
+    // Roots are collected first, since cuts will add new trees to the forest.
+    ulong rootsCnt;
+    FibTreeNode **roots = _listRoots(heap, &rootsCnt);
+    if (roots == NULL) return 0;
+
+    // Nodes cut in cascade become roots: all the trees they need are taken
+    // first, so that nothing can be lost.
+    ulong treesCnt = 0;
+    for (ulong i = 0; i < rootsCnt; i++)
+        treesCnt += _countCuts(roots[i], threshold);
+    DLList *spares = createDLList();
+    if ((spares == NULL) || (_reserveTrees(spares, treesCnt) != 0)) {
+        _eraseSpareTrees(spares);
+        free(roots);
+        return 0;
+    }
+
+    ulong deleted = 0;
+    for (ulong i = 0; i < rootsCnt; i++)
+        deleted += _pruneTree(heap, roots[i], threshold, NULL, spares, opts);
+    free(roots);
+    _eraseSpareTrees(spares);
+
+    heap->nodesCount -= deleted;
+    _updateMin(heap, NULL);
+    return deleted;
+}
+
+/* Deletes the count nodes with the greatest keys, freeing memory.
+ * Costs a linear scan of the heap to select the threshold key, so it should
+ * be used to shrink the structure in large steps (e.g. to bound its memory).
+ * Returns the number of deleted nodes (0 on failure, in which case the heap
+ * is left as it was).
+ */
+ulong fhDeleteWorst(FibHeap *heap, ulong count, int opts) {
+    if (heap == NULL) return 0;
+    if ((count == 0) || (heap->nodesCount == 0)) return 0;
+    if (count >= heap->nodesCount) count = heap->nodesCount;
+
+    // Collect all keys and select the smallest one among those to be dropped.
+    uint64_t *keys = calloc(heap->nodesCount, sizeof(uint64_t));
+    if (keys == NULL) return 0;
+    ulong rootsCnt, keysCnt = 0;
+    FibTreeNode **roots = _listRoots(heap, &rootsCnt);
+    if (roots == NULL) {
+        free(keys);
+        return 0;
+    }
+    for (ulong i = 0; i < rootsCnt; i++) _collectKeys(roots[i], keys, &keysCnt);
+    uint64_t threshold = _selectKey(keys, keysCnt, keysCnt - count);
+
+    // Nodes with the threshold key are dropped only as long as needed.
+    ulong above = 0, equal = 0;
+    for (ulong i = 0; i < keysCnt; i++) {
+        if (keys[i] > threshold) above++;
+        else if (keys[i] == threshold) equal++;
+    }
+    free(keys);
+    ulong ties = count - above;
+
+    // Sons left to dropped nodes have the threshold key too, and become
+    // roots, as do nodes cut in cascade, also by dropped ones: all the trees
+    // they need are taken first, so that nothing can be lost.
+    ulong treesCnt = ties * _maxOrder(heap->nodesCount);
+    if (treesCnt > equal) treesCnt = equal;
+    treesCnt += ties;
+    for (ulong i = 0; i < rootsCnt; i++)
+        treesCnt += _countCuts(roots[i], threshold);
+    DLList *spares = createDLList();
+    if ((spares == NULL) || (_reserveTrees(spares, treesCnt) != 0)) {
+        _eraseSpareTrees(spares);
+        free(roots);
+        return 0;
+    }
+
+    ulong deleted = 0;
+    for (ulong i = 0; i < rootsCnt; i++)
+        deleted += _pruneTree(heap, roots[i], threshold, &ties, spares, opts);
+    free(roots);
+    _eraseSpareTrees(spares);
+
+    heap->nodesCount -= deleted;
+    _updateMin(heap, NULL);
+    return deleted;
+}
+
+/* Applies a batch of n operations, as if in their order, with at most one
+ * consolidation. Insertions that are deleted within the batch are cancelled,
+ * all updates of a node are collapsed into its last one, and deleted or
+ * increased nodes are just cut from their trees before the consolidation.
+ * Operations that would underflow or overflow a key, or target a deleted
+ * node, fail without affecting the others. If memory runs out before the
+ * batch is applied, all operations fail and the heap is left as it was.
+ * Returns 0 if no operation failed, -1 otherwise.
+ */
+int fhApplyBatch(FibHeap *heap, FibOp *ops, ulong n) {
+    if ((heap == NULL) || ((ops == NULL) && (n > 0))) return -1;
+    if (n == 0) return 0;
+
+    // Node states are kept in a hash table, insertions in a parallel array.
+    ulong tableSize = 2;
+    while (tableSize < 2 * n) tableSize *= 2;
+    FibBatchEntry *table = calloc(tableSize, sizeof(FibBatchEntry));
+    FibBatchEntry *inserts = calloc(n, sizeof(FibBatchEntry));
+    if ((table == NULL) || (inserts == NULL)) {
+        for (ulong i = 0; i < n; i++) ops[i].status = FH_OP_FAILED;
+        free(table);
+        free(inserts);
+        return -1;
+    }
+
+    // Go through the batch, keeping only the final state of each target.
+    int ret = 0;
+    for (ulong i = 0; i < n; i++) {
+        FibOp *op = &(ops[i]);
+        op->status = FH_OP_ELIDED;
+        if (op->type == FH_OP_INSERT) {
+            inserts[i].key = op->key;
+            inserts[i].lastOp = i;
+            op->node = NULL;
+            continue;
+        }
+        FibBatchEntry *state = NULL;
+        if ((op->type >= FH_OP_DECREASE) && (op->type <= FH_OP_DELETE)) {
+            if (op->node != NULL)
+                state = _batchEntry(table, tableSize, op->node);
+            else if ((op->ref < i) && (ops[op->ref].type == FH_OP_INSERT))
+                state = &(inserts[op->ref]);
+        }
+        if ((state == NULL) || state->deleted ||
+            ((op->type != FH_OP_DELETE) && !_batchUpdate(op, &(state->key)))) {
+            op->status = FH_OP_FAILED;
+            ret = -1;
+            continue;
+        }
+        if (op->type == FH_OP_DELETE) state->deleted = 1;
+        if (op->node != NULL) state->lastOp = i;
+    }
+
+    // Sons of the nodes to be cut become roots, and so do increased nodes:
+    // all the trees they need are taken first, so that nothing can be lost.
+    ulong treesCnt = 0;
+    for (ulong i = 0; i < tableSize; i++) {
+        FibTreeNode *node = table[i].node;
+        if ((node == NULL) || (!table[i].deleted && (table[i].key <=
+                                                     node->key))) continue;
+        treesCnt += node->_sonsCnt + (table[i].deleted ? 0 : 1);
+    }
+    DLList *spares = createDLList();
+    if ((spares == NULL) || (_reserveTrees(spares, treesCnt) != 0)) {
+        for (ulong i = 0; i < n; i++) ops[i].status = FH_OP_FAILED;
+        _eraseSpareTrees(spares);
+        free(table);
+        free(inserts);
+        return -1;
+    }
+
+    // Apply what's left: cuts first, so that decreases see a valid min (or
+    // none), then insertions.
+    int restructured = 0;
+    for (ulong i = 0; i < tableSize; i++) {
+        FibTreeNode *node = table[i].node;
+        if ((node == NULL) || (table[i].lastOp == ULONG_MAX)) continue;
+        if (!table[i].deleted && (table[i].key <= node->key)) {
+            // Decreases come later, while updates that cancel out are done.
+            if (table[i].key == node->key)
+                ops[table[i].lastOp].status = FH_OP_DONE;
+            continue;
+        }
+        // Cut nodes must not be taken as minimum candidates in relaxed mode.
+        if (heap->_relaxRoots > 0) _relaxedDropCand(heap, node);
+        _cutNode(heap, node, spares);
+        node->_father = NULL;
+        node->_nextBro = NULL;
+        node->_prevBro = NULL;
+        restructured = 1;
+        if (table[i].deleted) heap->nodesCount--;
+        else {
+            // Increased nodes go back as single roots.
+            node->key = table[i].key;
+            _plantSpareTree(heap, spares, node);
+        }
+        ops[table[i].lastOp].status = FH_OP_DONE;
+    }
+    _eraseSpareTrees(spares);
+    for (ulong i = 0; i < tableSize; i++) {
+        FibTreeNode *node = table[i].node;
+        if ((node == NULL) || table[i].deleted || (table[i].key >= node->key))
+            continue;
+        fhDecreaseKey(heap, node, node->key - table[i].key);
+        ops[table[i].lastOp].status = FH_OP_DONE;
+    }
+    for (ulong i = 0; i < n; i++) {
+        if ((ops[i].type != FH_OP_INSERT) || inserts[i].deleted) continue;
+        ops[i].node = fhInsert(heap, ops[i].elem, inserts[i].key);
+        if (ops[i].node == NULL) {
+            ops[i].status = FH_OP_FAILED;
+            ret = -1;
+        } else ops[i].status = FH_OP_DONE;
+    }
+    free(table);
+    free(inserts);
 
-    return deletedNode;
+    // A single consolidation, if needed.
+    if (restructured) {
+        if (heap->_relaxRoots == 0) _rebuild(heap);
+        else _relaxedUpdateMin(heap, NULL);
+    }
+    return ret;
 }
 
 // INTERNAL LIBRARY SUBROUTINES //
@@ -233,6 +1039,8 @@ FibTreeNode *fhIncreaseKey(FibHeap *heap, FibTreeNode *node, uint64_t inc) {
 void _updateMin(FibHeap *heap, FibTreeNode *newNode) {
     if (isHeapEmpty(heap)) {
         heap->min = NULL;
+        heap->_lowBound = UINT64_MAX;
+        heap->_relaxCandsCnt = 0;
     } else {
         if (newNode == NULL) {
             // Slow mode: we don't have any clues apart from the fact that
@@ -250,15 +1058,21 @@ void _updateMin(FibHeap *heap, FibTreeNode *newNode) {
                 }
             }
             heap->min = newMin;
-        } else
+            heap->_lowBound = newMinKey;
+            if (heap->_relaxRoots > 0) _relaxedFillCands(heap);
+        } else {
             // Fast mode: we already know the node that has been modified.
             if ((heap->min == NULL) || (newNode->key < heap->min->key))
                 heap->min = newNode;
+            if (newNode->key < heap->_lowBound)
+                heap->_lowBound = newNode->key;
+        }
     }
 }
 
 /* Merges identical trees and restores uniqueness property. */
 void _rebuild(FibHeap *heap) {
+    if ((heap->_rebuildThreads > 1) && (_parallelRebuild(heap) == 0)) return;
     for (ulong i = 0; i < heap->_maxTreeOrd; i++) {
         while ((heap->_forest)[i]->recsCount > 1) {
             Record *aRecordedTree = popFirstRecord((heap->_forest)[i]);
@@ -285,6 +1099,127 @@ void _rebuild(FibHeap *heap) {
     _updateMin(heap, NULL);
 }
 
+/* Consolidates the forest on multiple threads, if it has enough roots.
+ * Roots are taken out of the forest, and linked again (see "_consolidate").
+ * Returns 0 if the forest was consolidated, -1 if the serial algorithm must
+ * be used instead (the forest is left untouched in that case).
+ */
+int _parallelRebuild(FibHeap *heap) {
+    ulong rootsCnt = 0;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++)
+        rootsCnt += (heap->_forest)[i]->recsCount;
+    if (rootsCnt < heap->_rebuildMinRoots) return -1;
+    DLList *spares = _reserveRebuild(heap, rootsCnt);
+    if (spares == NULL) return -1;
+    FibTreeNode **roots = _listRoots(heap, &rootsCnt);
+    if (roots == NULL) {
+        _eraseSpareTrees(spares);
+        return -1;
+    }
+    _consolidate(heap, roots, rootsCnt, heap->_rebuildThreads, spares);
+    free(roots);
+    _updateMin(heap, NULL);
+    return 0;
+}
+
+/* Gets what a consolidation of rootsCnt roots needs, so that it can't fail
+ * halfway: the lists for all orders its trees may have, and a tree for each
+ * of them (those in the forest are recycled, so new ones are seldom needed).
+ * Returns a list of spare trees for "_consolidate", or NULL on failure.
+ */
+DLList *_reserveRebuild(FibHeap *heap, ulong rootsCnt) {
+    ulong maxOrd = _maxOrder(heap->nodesCount);
+    ulong newTreesCnt = rootsCnt < maxOrd + 1 ? rootsCnt : maxOrd + 1;
+    ulong treesCnt = 0;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++)
+        treesCnt += (heap->_forest)[i]->recsCount;
+    DLList *spares = createDLList();
+    if ((spares == NULL) || (_growForest(heap, maxOrd) != 0) ||
+        ((newTreesCnt > treesCnt) &&
+         (_reserveTrees(spares, newTreesCnt - treesCnt) != 0))) {
+        _eraseSpareTrees(spares);
+        return NULL;
+    }
+    return spares;
+}
+
+/* Replaces the forest with trees of distinct orders, linked from the given
+ * roots (which need not be in the forest). Roots are split in slices, each
+ * linked by a thread into its own table of trees by order; then the tables
+ * are merged. If threads can't be used, everything is done by the calling
+ * thread. Trees of the old forest, and the spare ones, are used for the new
+ * trees (see "_reserveRebuild"), and those left are freed.
+ */
+void _consolidate(FibHeap *heap, FibTreeNode **roots, ulong rootsCnt,
+                  ulong threadsCnt, DLList *spares) {
+    FibRebuildSlice single = {0};
+    FibRebuildSlice *slices = &single;
+    pthread_t *threads = NULL;
+    if (threadsCnt > rootsCnt) threadsCnt = rootsCnt;
+    if (threadsCnt > 1) {
+        slices = calloc(threadsCnt, sizeof(FibRebuildSlice));
+        threads = calloc(threadsCnt, sizeof(pthread_t));
+        if ((slices == NULL) || (threads == NULL)) {
+            free(slices);
+            free(threads);
+            slices = &single;
+            threads = NULL;
+            threadsCnt = 1;
+        }
+    } else threadsCnt = 1;
+
+    // Link the slices, the first one on this thread.
+    ulong sliceSize = rootsCnt / threadsCnt;
+    for (ulong i = 0; i < threadsCnt; i++) {
+        slices[i].roots = roots + (i * sliceSize);
+        slices[i].rootsCnt = i < (threadsCnt - 1) ? sliceSize :
+                             rootsCnt - (i * sliceSize);
+    }
+    ulong started = 0;
+    for (ulong i = 1; i < threadsCnt; i++) {
+        if (pthread_create(&(threads[i]), NULL, _linkSlice, &(slices[i])))
+            break;  // Go on with the ones we got.
+        started++;
+    }
+    for (ulong i = started + 1; i < threadsCnt; i++) _linkSlice(&(slices[i]));
+    _linkSlice(&(slices[0]));
+    for (ulong i = 1; i <= started; i++) pthread_join(threads[i], NULL);
+
+    // Merge the tables into the first one, and plant its trees.
+    for (ulong i = 1; i < threadsCnt; i++)
+        for (ulong ord = 0; ord < FH_ORD_TABLE_SIZE; ord++)
+            if ((slices[i].table)[ord] != NULL)
+                _tableAdd(slices[0].table, (slices[i].table)[ord]);
+    _takeForest(heap, spares);
+    for (ulong ord = 0; ord < FH_ORD_TABLE_SIZE; ord++)
+        if ((slices[0].table)[ord] != NULL)
+            _plantSpareTree(heap, spares, (slices[0].table)[ord]);
+    _eraseSpareTrees(spares);
+    if (slices != &single) free(slices);
+    free(threads);
+}
+
+/* Links the roots of a slice into its table of trees by order. */
+void *_linkSlice(void *arg) {
+    FibRebuildSlice *slice = arg;
+    for (ulong i = 0; i < slice->rootsCnt; i++)
+        _tableAdd(slice->table, (slice->roots)[i]);
+    return NULL;
+}
+
+/* Adds a detached tree to a table of trees by order, linking it to the tree
+ * of the same order, if any, and so on.
+ */
+void _tableAdd(FibTreeNode **table, FibTreeNode *root) {
+    root->_posInForest = NULL;
+    while (table[root->_sonsCnt] != NULL) {
+        ulong ord = root->_sonsCnt;
+        root = _linkRoots(table[ord], root);
+        table[ord] = NULL;
+    }
+    table[root->_sonsCnt] = root;
+}
+
 /* Merges two Fibonacci Trees. */
 Record *_mergeRecordedTrees(FibTree *tree, FibTree *otherTree,
                             Record *firstTreeRecord, Record *otherTreeRecord) {
@@ -330,18 +1265,31 @@ void _eraseTree(FibTree *tree, int opts) {
     free(tree);
 }
 
-/* Recursively deletes a subtree rooted in a given node. Works as a DFS. */
-void _eraseSubtree(FibTreeNode *root, int opts) {
+/* Recursively deletes a subtree rooted in a given node. Works as a DFS.
+ * Returns the number of deleted nodes.
+ */
+ulong _eraseSubtree(FibTreeNode *root, int opts) {
+    ulong erased = 1;
     FibTreeNode *currSon = root->_firstSon;
     while (currSon != NULL) {
         // Recursive step: visit all sons and delete them.
         FibTreeNode *nextOne = currSon->_nextBro;
-        _eraseSubtree(currSon, opts);
+        erased += _eraseSubtree(currSon, opts);
         currSon = nextOne;
     }
     // Also base step: node has no sons, so delete it.
     if (opts & DELETE_FREE_DATA) free(root->elem);
-    free(root);
+    if (opts & DELETE_KEEP_NODES) {
+        // Leave it detached, as if it had just been deleted from the heap.
+        root->_father = NULL;
+        root->_firstSon = NULL;
+        root->_nextBro = NULL;
+        root->_prevBro = NULL;
+        root->_posInForest = NULL;
+        root->_sonsCnt = 0;
+        root->_grief = 0;
+    } else _freeNode(root);
+    return erased;
 }
 
 /* Sets the father of all the first-level sons of a root to NULL. */
@@ -358,14 +1306,14 @@ FibTreeNode *_insertNode(FibHeap *heap, FibTreeNode *node) {
     // Create new B0 tree.
     FibTree *newTree = calloc(1, sizeof(FibTree));
     if (newTree == NULL) {
-        free(node);
+        _freeNode(node);
         return NULL;
     }
     newTree->_root = node;
     // Add the new tree to the B0s list and update the min pointer.
     Record *newTreeRec = addAsLast(newTree, (heap->_forest)[0]);
     if (newTreeRec == NULL) {
-        free(node);
+        _freeNode(node);
         free(newTree);
         return NULL;
     }
@@ -375,8 +1323,10 @@ FibTreeNode *_insertNode(FibHeap *heap, FibTreeNode *node) {
     return newTree->_root;
 }
 
-/* Restores the structure of a Fibonacci Tree, detaching subtrees. */
-void _cascadedDetach(FibHeap *heap, FibTreeNode *decNode) {
+/* Restores the structure of a Fibonacci Tree, detaching subtrees. Detached
+ * nodes become roots of spare trees as long as a list of them has any left.
+ */
+void _cascadedDetach(FibHeap *heap, FibTreeNode *decNode, DLList *spares) {
     FibTreeNode *father = decNode->_father;  // This always exists.
     // Detach this node from its brothers and father.
     if (father->_firstSon == decNode) father->_firstSon = decNode->_nextBro;
@@ -388,6 +1338,11 @@ void _cascadedDetach(FibHeap *heap, FibTreeNode *decNode) {
     decNode->_nextBro = NULL;
     decNode->_prevBro = NULL;
     father->_sonsCnt--;
+    if ((spares != NULL) && !isListEmpty(spares)) {
+        _plantSpareTree(heap, spares, decNode);
+        _sonLost(heap, father, spares);
+        return;
+    }
     // Create a new tree with this node as root.
     FibTree *newTree = calloc(1, sizeof(FibTree));
     if (newTree == NULL) return;  // Shit incoming...
@@ -404,9 +1359,14 @@ void _cascadedDetach(FibHeap *heap, FibTreeNode *decNode) {
     // Reset this node's grief.
     decNode->_grief = 0;
     // Now, you may have to do this again. Go up and check out!
+    _sonLost(heap, father, spares);
+}
+
+/* Updates a node that just lost a son, going on with the cascade if needed. */
+void _sonLost(FibHeap *heap, FibTreeNode *father, DLList *spares) {
     // Note that, in Fibonacci Trees, each node is allowed to lose one son only.
     if (father->_father != NULL) {
-        if (father->_grief == 1) _cascadedDetach(heap, father);
+        if (father->_grief == 1) _cascadedDetach(heap, father, spares);
         else father->_grief = 1;  // Mark the loss of the node above.
     } else
         // The father is a root. Since it lost a son, it must be moved to the
@@ -415,3 +1375,658 @@ void _cascadedDetach(FibHeap *heap, FibTreeNode *decNode) {
                 (heap->_forest)[father->_sonsCnt + 1]),
                 (heap->_forest)[father->_sonsCnt]);
 }
+
+/* Detaches a node from its father and brothers, without adding it to the
+ * forest. The father is updated as if the node had been cut (see
+ * "_cascadedDetach").
+ */
+void _unlinkSon(FibHeap *heap, FibTreeNode *son, DLList *spares) {
+    FibTreeNode *father = son->_father;
+    if (father->_firstSon == son) father->_firstSon = son->_nextBro;
+    if (son->_prevBro != NULL) son->_prevBro->_nextBro = son->_nextBro;
+    if (son->_nextBro != NULL) son->_nextBro->_prevBro = son->_prevBro;
+    son->_father = NULL;
+    son->_nextBro = NULL;
+    son->_prevBro = NULL;
+    father->_sonsCnt--;
+    _sonLost(heap, father, spares);
+}
+
+/* Adds a detached node to the forest as the root of a new tree.
+ * Returns 1 on success, 0 on failure.
+ */
+int _plantTree(FibHeap *heap, FibTreeNode *root) {
+    FibTree *newTree = calloc(1, sizeof(FibTree));
+    if (newTree == NULL) return 0;
+    newTree->_root = root;
+    Record *newTreeRec = addAsLast(newTree, (heap->_forest)[root->_sonsCnt]);
+    if (newTreeRec == NULL) {
+        free(newTree);
+        return 0;
+    }
+    root->_father = NULL;
+    root->_grief = 0;
+    root->_posInForest = newTreeRec;
+    return 1;
+}
+
+/* Returns a new array with the current roots of the heap. */
+FibTreeNode **_listRoots(FibHeap *heap, ulong *rootsCnt) {
+    ulong cnt = 0;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++)
+        cnt += (heap->_forest)[i]->recsCount;
+    FibTreeNode **roots = calloc(cnt + 1, sizeof(FibTreeNode *));
+    if (roots == NULL) return NULL;
+    cnt = 0;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++) {
+        Record *curr = (heap->_forest)[i]->first;
+        while (curr != NULL) {
+            roots[cnt++] = ((FibTree *)(curr->recData))->_root;
+            curr = curr->next;
+        }
+    }
+    *rootsCnt = cnt;
+    return roots;
+}
+
+/* Tells whether a node with a given key must be pruned. */
+int _mustPrune(uint64_t key, uint64_t threshold, ulong *ties) {
+    return (key > threshold) ||
+           ((key == threshold) && (ties != NULL) && (*ties > 0));
+}
+
+/* Returns a bound on the nodes that pruning a subtree above a threshold may
+ * cut in cascade: each unlinked subtree cuts marked nodes, and marks at most
+ * one more, which can be cut later on. Nodes dropped for ties are not
+ * counted (see "_pruneSubtree").
+ */
+ulong _countCuts(FibTreeNode *root, uint64_t threshold) {
+    if (root->key > threshold) return root->_father != NULL ? 1 : 0;
+    ulong cnt = ((root->_father != NULL) && (root->_grief == 1)) ? 1 : 0;
+    FibTreeNode *currSon = root->_firstSon;
+    while (currSon != NULL) {
+        cnt += _countCuts(currSon, threshold);
+        currSon = currSon->_nextBro;
+    }
+    return cnt;
+}
+
+/* Removes a single node from the heap, freeing memory. Its sons, and the
+ * nodes cut in cascade, become new roots of spare trees. The nodes counter
+ * is not updated.
+ */
+void _dropNode(FibHeap *heap, FibTreeNode *node, DLList *spares, int opts) {
+    if (node->_father != NULL) _unlinkSon(heap, node, spares);
+    _cutNode(heap, node, spares);
+    _eraseSubtree(node, opts);
+}
+
+/* Takes a single node out of the heap, leaving it detached (it may already be
+ * unlinked from its father). Its sons become new roots of spare trees, one
+ * for each, and nothing is consolidated. The nodes counter is not updated,
+ * and the min pointer is cleared if it pointed to this node.
+ */
+void _cutNode(FibHeap *heap, FibTreeNode *node, DLList *spares) {
+    if (node->_father != NULL) {
+        _unlinkSon(heap, node, NULL);
+    } else if (node->_posInForest != NULL) {
+        Record *treeRecord = popRecord(node->_posInForest,
+                                       (heap->_forest)[node->_sonsCnt]);
+        free(treeRecord->recData);
+        eraseRecord(treeRecord);
+    }
+    while (node->_firstSon != NULL) {
+        FibTreeNode *orphan = node->_firstSon;
+        node->_firstSon = orphan->_nextBro;
+        orphan->_nextBro = NULL;
+        orphan->_prevBro = NULL;
+        _plantSpareTree(heap, spares, orphan);
+    }
+    node->_sonsCnt = 0;
+    node->_posInForest = NULL;
+    node->_grief = 0;
+    if (heap->min == node) heap->min = NULL;
+}
+
+/* Prunes all sons of a node (and their descendants) from the heap.
+ * Sons above the threshold are erased together with their subtrees. When a
+ * counter of ties is given, that many nodes with key equal to the threshold
+ * are erased too, and their remaining sons become new roots. New roots take
+ * spare trees, which must be enough (see "_countCuts").
+ * Returns the number of deleted nodes.
+ */
+ulong _pruneSubtree(FibHeap *heap, FibTreeNode *root, uint64_t threshold,
+                    ulong *ties, DLList *spares, int opts) {
+    ulong deleted = 0;
+    FibTreeNode *currSon = root->_firstSon;
+    while (currSon != NULL) {
+        FibTreeNode *nextOne = currSon->_nextBro;
+        if (currSon->key > threshold) {
+            _unlinkSon(heap, currSon, spares);
+            deleted += _eraseSubtree(currSon, opts);
+        } else {
+            // Note that this son could become a root in the meantime, due to
+            // the cuts that its descendants may cause.
+            deleted += _pruneSubtree(heap, currSon, threshold, ties, spares,
+                                     opts);
+            if (_mustPrune(currSon->key, threshold, ties)) {
+                _dropNode(heap, currSon, spares, opts);
+                (*ties)--;
+                deleted++;
+            }
+        }
+        currSon = nextOne;
+    }
+    return deleted;
+}
+
+/* Prunes a whole tree of the heap, given its root (see "_pruneSubtree").
+ * Returns the number of deleted nodes.
+ */
+ulong _pruneTree(FibHeap *heap, FibTreeNode *root, uint64_t threshold,
+                 ulong *ties, DLList *spares, int opts) {
+    if (root->key > threshold) {
+        // The whole tree goes away.
+        Record *treeRecord = popRecord(root->_posInForest,
+                                       (heap->_forest)[root->_sonsCnt]);
+        free(treeRecord->recData);
+        eraseRecord(treeRecord);
+        return _eraseSubtree(root, opts);
+    }
+    ulong deleted = _pruneSubtree(heap, root, threshold, ties, spares, opts);
+    if (_mustPrune(root->key, threshold, ties)) {
+        _dropNode(heap, root, spares, opts);
+        (*ties)--;
+        deleted++;
+    }
+    return deleted;
+}
+
+/* Recursively collects the keys of a subtree. Works as a DFS. */
+void _collectKeys(FibTreeNode *root, uint64_t *keys, ulong *pos) {
+    keys[(*pos)++] = root->key;
+    FibTreeNode *currSon = root->_firstSon;
+    while (currSon != NULL) {
+        _collectKeys(currSon, keys, pos);
+        currSon = currSon->_nextBro;
+    }
+}
+
+/* Returns the k-th smallest key (from 0) of an array, reordering it.
+ * This is an iterative quickselect.
+ */
+uint64_t _selectKey(uint64_t *keys, ulong n, ulong k) {
+    ulong lo = 0, hi = n - 1;
+    while (lo < hi) {
+        uint64_t pivot = keys[lo + ((hi - lo) / 2)];
+        ulong i = lo, j = hi;
+        while (i <= j) {
+            while (keys[i] < pivot) i++;
+            while (keys[j] > pivot) j--;
+            if (i <= j) {
+                uint64_t tmp = keys[i];
+                keys[i] = keys[j];
+                keys[j] = tmp;
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
+        if (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else break;
+    }
+    return keys[k];
+}
+
+/* Allocates a new node, from the heap's pool if it has one. */
+FibTreeNode *_newNode(FibHeap *heap) {
+    FibNodePool *pool = heap->_pool;
+    if (pool == NULL) return calloc(1, sizeof(FibTreeNode));
+    FibTreeNode *node = pool->_freeList;
+    if (node != NULL) {
+        pool->_freeList = node->_nextBro;
+        node->_nextBro = NULL;
+        return node;
+    }
+    return _newChunkNode(pool);
+}
+
+/* Takes a new node from the last chunk of a pool, adding one if needed, so
+ * that consecutive calls return adjacent nodes (but at chunk boundaries).
+ */
+FibTreeNode *_newChunkNode(FibNodePool *pool) {
+    if (pool->_used > UINT32_MAX) return NULL;  // Indexes are exhausted.
+    ulong chunkSize = 1UL << FH_POOL_CHUNK_ORD;
+    if (pool->_used == pool->_chunksCnt * chunkSize) {
+        FibTreeNode **newChunks = reallocarray(pool->_chunks,
+                                               pool->_chunksCnt + 1,
+                                               sizeof(FibTreeNode *));
+        if (newChunks == NULL) return NULL;
+        pool->_chunks = newChunks;
+        newChunks[pool->_chunksCnt] = calloc(chunkSize, sizeof(FibTreeNode));
+        if (newChunks[pool->_chunksCnt] == NULL) return NULL;
+        pool->_chunksCnt++;
+    }
+    FibTreeNode *node = &((pool->_chunks)[pool->_used >> FH_POOL_CHUNK_ORD]
+             [pool->_used & (chunkSize - 1)]);
+    node->_pool = pool;
+    node->_poolIdx = (uint32_t)(pool->_used);
+    node->_gen = 1;
+    pool->_used++;
+    return node;
+}
+
+/* Frees a node, or gives it back to its pool, invalidating its handles. */
+void _freeNode(FibTreeNode *node) {
+    FibNodePool *pool = node->_pool;
+    if (pool == NULL) {
+        free(node);
+        return;
+    }
+    node->_father = NULL;
+    node->_firstSon = NULL;
+    node->_prevBro = NULL;
+    node->_posInForest = NULL;
+    node->_gen++;
+    if (node->_gen == 0) node->_gen = 1;  // Keep handles nonzero.
+    node->_nextBro = pool->_freeList;
+    pool->_freeList = node;
+}
+
+/* Returns the order that sorts an array of keys, as an array of positions,
+ * computed with a stable LSD radix sort, one byte at a time. Bytes that are
+ * equal in all keys are skipped.
+ * Returns NULL on failure.
+ */
+ulong *_radixOrder(uint64_t *keys, ulong n) {
+    ulong *order = calloc(n, sizeof(ulong));
+    ulong *tmp = calloc(n, sizeof(ulong));
+    ulong (*counts)[256] = calloc(8, sizeof(*counts));
+    if ((order == NULL) || (tmp == NULL) || (counts == NULL)) {
+        free(order);
+        free(tmp);
+        free(counts);
+        return NULL;
+    }
+    for (ulong i = 0; i < n; i++) {
+        order[i] = i;
+        for (ulong b = 0; b < 8; b++)
+            counts[b][(keys[i] >> (8 * b)) & 0xFF]++;
+    }
+    for (ulong b = 0; b < 8; b++) {
+        if (counts[b][(keys[0] >> (8 * b)) & 0xFF] == n) continue;
+        ulong pos = 0;
+        for (ulong d = 0; d < 256; d++) {
+            ulong cnt = counts[b][d];
+            counts[b][d] = pos;
+            pos += cnt;
+        }
+        for (ulong i = 0; i < n; i++)
+            tmp[counts[b][(keys[order[i]] >> (8 * b)) & 0xFF]++] = order[i];
+        ulong *swap = order;
+        order = tmp;
+        tmp = swap;
+    }
+    free(tmp);
+    free(counts);
+    return order;
+}
+
+/* Stores the n nodes with the smallest keys in a heap, in ascending order.
+ * Nodes are visited in key order from the roots, keeping the frontier in a
+ * binary heap of nodes. If asked, the final frontier is handed over too: it
+ * holds the roots of the heap once the nodes found are removed (or NULL, if
+ * the visit can't start).
+ * Returns the number of nodes stored (fewer than n if the heap has fewer
+ * nodes, or on failure).
+ */
+ulong _smallestNodes(FibHeap *heap, ulong n, FibTreeNode **nodes,
+                     FibTreeNode ***frontier, ulong *frontierCnt) {
+    ulong candsCnt;
+    FibTreeNode **cands = _listRoots(heap, &candsCnt);
+    if (cands == NULL) {
+        if (frontier != NULL) {
+            *frontier = NULL;
+            *frontierCnt = 0;
+        }
+        return 0;
+    }
+    ulong candsCap = candsCnt + 1;
+    for (ulong i = candsCnt / 2; i-- > 0;) _siftDownNode(cands, candsCnt, i);
+    ulong found = 0;
+    while ((found < n) && (candsCnt > 0)) {
+        FibTreeNode *next = cands[0];
+        // Sons of a visited node become candidates, so make room first.
+        if (candsCnt + next->_sonsCnt > candsCap) {
+            ulong newCap = 2 * (candsCnt + next->_sonsCnt);
+            FibTreeNode **newCands = reallocarray(cands, newCap,
+                                                  sizeof(FibTreeNode *));
+            if (newCands == NULL) break;
+            cands = newCands;
+            candsCap = newCap;
+        }
+        nodes[found++] = next;
+        cands[0] = cands[--candsCnt];
+        _siftDownNode(cands, candsCnt, 0);
+        if ((found == n) && (frontier == NULL)) break;
+        FibTreeNode *currSon = next->_firstSon;
+        while (currSon != NULL) {
+            cands[candsCnt] = currSon;
+            _siftUpNode(cands, candsCnt++);
+            currSon = currSon->_nextBro;
+        }
+    }
+    if (frontier != NULL) {
+        *frontier = cands;
+        *frontierCnt = candsCnt;
+    } else free(cands);
+    return found;
+}
+
+/* Moves a node up in a binary heap of nodes, ordered by key. */
+void _siftUpNode(FibTreeNode **nodes, ulong pos) {
+    FibTreeNode *node = nodes[pos];
+    while (pos > 0) {
+        ulong father = (pos - 1) / 2;
+        if (nodes[father]->key <= node->key) break;
+        nodes[pos] = nodes[father];
+        pos = father;
+    }
+    nodes[pos] = node;
+}
+
+/* Moves a node down in a binary heap of cnt nodes, ordered by key. */
+void _siftDownNode(FibTreeNode **nodes, ulong cnt, ulong pos) {
+    if (pos >= cnt) return;
+    FibTreeNode *node = nodes[pos];
+    while ((2 * pos) + 1 < cnt) {
+        ulong son = (2 * pos) + 1;
+        if ((son + 1 < cnt) && (nodes[son + 1]->key < nodes[son]->key)) son++;
+        if (node->key <= nodes[son]->key) break;
+        nodes[pos] = nodes[son];
+        pos = son;
+    }
+    nodes[pos] = node;
+}
+
+/* Returns the entry of a node in the hash table of a batch, adding it if
+ * needed. Uses linear probing.
+ */
+FibBatchEntry *_batchEntry(FibBatchEntry *table, ulong size,
+                           FibTreeNode *node) {
+    ulong pos = _hashId((uint64_t)(uintptr_t)node) & (size - 1);
+    while ((table[pos].node != NULL) && (table[pos].node != node))
+        pos = (pos + 1) & (size - 1);
+    if (table[pos].node == NULL) {
+        table[pos].node = node;
+        table[pos].key = node->key;
+        table[pos].lastOp = ULONG_MAX;
+    }
+    return &(table[pos]);
+}
+
+/* Applies a key update of a batch to a key.
+ * Returns 1 on success, 0 if the key would underflow or overflow.
+ */
+int _batchUpdate(FibOp *op, uint64_t *key) {
+    if (op->type == FH_OP_DECREASE) {
+        if (op->key > *key) return 0;
+        *key -= op->key;
+    } else {
+        if (op->key > UINT64_MAX - *key) return 0;
+        *key += op->key;
+    }
+    return 1;
+}
+
+/* Mixes the bits of an ID for hashing (this is SplitMix64's finalizer). */
+uint64_t _hashId(uint64_t id) {
+    id ^= id >> 30;
+    id *= 0xBF58476D1CE4E5B9ULL;
+    id ^= id >> 27;
+    id *= 0x94D049BB133111EBULL;
+    id ^= id >> 31;
+    return id;
+}
+
+/* Looks for the entry of an ID in a sparse index.
+ * Returns the entry only if it refers to a node in the heap, while stale
+ * entries are removed as they are found.
+ */
+FibIndexEntry *_findEntry(FibHeap *heap, uint64_t id) {
+    FibIndex *index = heap->_index;
+    ulong mask = index->_size - 1;
+    ulong pos = _hashId(id) & mask;
+    while ((index->_entries)[pos].handle != FH_NULL_HANDLE) {
+        FibIndexEntry *entry = &((index->_entries)[pos]);
+        if (entry->id == id) {
+            if (fhResolve(heap, entry->handle) != NULL) return entry;
+            _removeEntry(index, entry);
+            return NULL;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return NULL;
+}
+
+/* Removes an entry from a sparse index, shifting back the following ones so
+ * that no tombstones are needed.
+ */
+void _removeEntry(FibIndex *index, FibIndexEntry *entry) {
+    ulong mask = index->_size - 1;
+    ulong hole = (ulong)(entry - index->_entries);
+    ulong pos = hole;
+    while (1) {
+        pos = (pos + 1) & mask;
+        FibIndexEntry *next = &((index->_entries)[pos]);
+        if (next->handle == FH_NULL_HANDLE) break;
+        // Move this entry into the hole only if its home position doesn't
+        // lie cyclically in (hole, pos].
+        ulong home = _hashId(next->id) & mask;
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+            (index->_entries)[hole] = *next;
+            hole = pos;
+        }
+    }
+    (index->_entries)[hole].handle = FH_NULL_HANDLE;
+    index->_used--;
+}
+
+/* Rebuilds a sparse index with a new size, dropping stale entries.
+ * Returns 0 on success, -1 on failure.
+ */
+int _resizeIndex(FibHeap *heap, ulong newSize) {
+    FibIndex *index = heap->_index;
+    FibIndexEntry *newEntries = calloc(newSize, sizeof(FibIndexEntry));
+    if (newEntries == NULL) return -1;
+    ulong mask = newSize - 1, used = 0;
+    for (ulong i = 0; i < index->_size; i++) {
+        FibIndexEntry *entry = &((index->_entries)[i]);
+        if ((entry->handle == FH_NULL_HANDLE) ||
+            (fhResolve(heap, entry->handle) == NULL)) continue;
+        ulong pos = _hashId(entry->id) & mask;
+        while (newEntries[pos].handle != FH_NULL_HANDLE)
+            pos = (pos + 1) & mask;
+        newEntries[pos] = *entry;
+        used++;
+    }
+    free(index->_entries);
+    index->_entries = newEntries;
+    index->_size = newSize;
+    index->_used = used;
+    return 0;
+}
+
+/* Recursively transforms the keys of the descendants of a node (whose key
+ * has already been transformed). Works as a DFS.
+ * Returns 1 if the heap order holds in the subtree, 0 otherwise.
+ */
+int _transformSubtree(FibTreeNode *root,
+                      uint64_t (*fn)(uint64_t key, void *ctx), void *ctx) {
+    int ordered = 1;
+    FibTreeNode *currSon = root->_firstSon;
+    while (currSon != NULL) {
+        currSon->key = fn(currSon->key, ctx);
+        if (currSon->key < root->key) ordered = 0;
+        ordered &= _transformSubtree(currSon, fn, ctx);
+        currSon = currSon->_nextBro;
+    }
+    return ordered;
+}
+
+/* Links two detached roots, making the one with the greater key the first
+ * son of the other. Returns the new root.
+ */
+FibTreeNode *_linkRoots(FibTreeNode *root, FibTreeNode *otherRoot) {
+    if (otherRoot->key < root->key) {
+        FibTreeNode *tmp = root;
+        root = otherRoot;
+        otherRoot = tmp;
+    }
+    otherRoot->_father = root;
+    otherRoot->_prevBro = NULL;
+    otherRoot->_nextBro = root->_firstSon;
+    otherRoot->_posInForest = NULL;
+    if (root->_firstSon != NULL) root->_firstSon->_prevBro = otherRoot;
+    root->_firstSon = otherRoot;
+    root->_sonsCnt++;
+    return root;
+}
+
+/* Extends the forest so that it has a list for trees of a given order.
+ * Returns 0 on success, -1 on failure.
+ */
+int _growForest(FibHeap *heap, ulong treeOrd) {
+    while (treeOrd >= heap->_maxTreeOrd) {
+        DLList **newForest = reallocarray(heap->_forest,
+                                          heap->_maxTreeOrd + 1,
+                                          sizeof(DLList *));
+        if (newForest == NULL) return -1;
+        heap->_forest = newForest;
+        (heap->_forest)[heap->_maxTreeOrd] = createDLList();
+        if ((heap->_forest)[heap->_maxTreeOrd] == NULL) return -1;
+        heap->_maxTreeOrd++;
+    }
+    return 0;
+}
+
+/* Returns the greatest order of a tree with up to nodesCnt nodes: a tree of
+ * order d has at least F(d + 2) nodes (F being Fibonacci numbers).
+ */
+ulong _maxOrder(ulong nodesCnt) {
+    ulong ord = 0, minNodes = 1, nextMinNodes = 2;
+    while (nextMinNodes <= nodesCnt) {
+        ord++;
+        if (nextMinNodes > ULONG_MAX - minNodes) break;
+        ulong tmp = minNodes + nextMinNodes;
+        minNodes = nextMinNodes;
+        nextMinNodes = tmp;
+    }
+    return ord;
+}
+
+/* Adds cnt new empty trees to a list of spare ones, to be planted later
+ * without allocations (see "_plantSpareTree").
+ * Returns 0 on success, -1 on failure.
+ */
+int _reserveTrees(DLList *spares, ulong cnt) {
+    for (ulong i = 0; i < cnt; i++) {
+        FibTree *newTree = calloc(1, sizeof(FibTree));
+        if (newTree == NULL) return -1;
+        if (addAsLast(newTree, spares) == NULL) {
+            free(newTree);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Moves all trees of the forest to a list of spare ones. */
+void _takeForest(FibHeap *heap, DLList *spares) {
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++) {
+        Record *currTree = popFirstRecord((heap->_forest)[i]);
+        while (currTree != NULL) {
+            addAsLastRecord(currTree, spares);
+            currTree = popFirstRecord((heap->_forest)[i]);
+        }
+    }
+}
+
+/* Adds a detached node to the forest as the root of a spare tree. There must
+ * be one, as well as a list for the order of the node.
+ */
+void _plantSpareTree(FibHeap *heap, DLList *spares, FibTreeNode *root) {
+    Record *treeRec = popFirstRecord(spares);
+    ((FibTree *)(treeRec->recData))->_root = root;
+    addAsLastRecord(treeRec, (heap->_forest)[root->_sonsCnt]);
+    root->_father = NULL;
+    root->_grief = 0;
+    root->_posInForest = treeRec;
+}
+
+/* Frees a list of spare trees, with those still in it. */
+void _eraseSpareTrees(DLList *spares) {
+    if (spares == NULL) return;
+    while (!isListEmpty(spares)) free(popFirst(spares));
+    eraseList(spares);
+}
+
+/* Finds a new minimum after a deletion in relaxed mode. Trees are
+ * consolidated only if there are too many of them; otherwise, the first
+ * candidate that is still a root with a good enough key is taken, and the
+ * roots are scanned again only if there is none.
+ */
+void _relaxedUpdateMin(FibHeap *heap, FibTreeNode *deleted) {
+    // The deleted node could have been a candidate too.
+    _relaxedDropCand(heap, deleted);
+    ulong rootsCnt = 0;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++)
+        rootsCnt += (heap->_forest)[i]->recsCount;
+    if (rootsCnt > heap->_relaxRoots) {
+        _rebuild(heap);
+        return;
+    }
+    uint64_t goodEnough = heap->_lowBound + heap->_relaxEps;
+    if (goodEnough < heap->_lowBound) goodEnough = UINT64_MAX;
+    while (heap->_relaxCandsCnt > 0) {
+        FibTreeNode *cand = (heap->_relaxCands)[--(heap->_relaxCandsCnt)];
+        if ((cand->_father == NULL) && (cand->_posInForest != NULL) &&
+            (cand->key <= goodEnough)) {
+            heap->min = cand;
+            return;
+        }
+    }
+    _updateMin(heap, NULL);
+}
+
+/* Collects the roots, other than the minimum, whose keys are within the
+ * admitted error of the minimum one, as candidates for the next deletions.
+ */
+void _relaxedFillCands(FibHeap *heap) {
+    uint64_t goodEnough = heap->_lowBound + heap->_relaxEps;
+    if (goodEnough < heap->_lowBound) goodEnough = UINT64_MAX;
+    heap->_relaxCandsCnt = 0;
+    for (ulong i = 0; i < heap->_maxTreeOrd; i++) {
+        Record *curr = (heap->_forest)[i]->first;
+        while (curr != NULL) {
+            FibTreeNode *root = ((FibTree *)(curr->recData))->_root;
+            if ((root != heap->min) && (root->key <= goodEnough)) {
+                (heap->_relaxCands)[(heap->_relaxCandsCnt)++] = root;
+                if (heap->_relaxCandsCnt == FH_RELAX_CANDS) return;
+            }
+            curr = curr->next;
+        }
+    }
+}
+
+/* Removes a node from the candidates of relaxed mode, if it is one. */
+void _relaxedDropCand(FibHeap *heap, FibTreeNode *node) {
+    for (ulong i = 0; i < heap->_relaxCandsCnt; i++) {
+        if ((heap->_relaxCands)[i] == node) {
+            (heap->_relaxCands)[i] =
+                (heap->_relaxCands)[--(heap->_relaxCandsCnt)];
+            return;
+        }
+    }
+}
@@ -17,13 +17,74 @@
  * aliasing, which is not preventable, e.g. "fhDelete" should be used instead
  * of "fhDeleteMin", even if the target node is the minimum.
  * NOTE: A value of "0" for the key is considered the minimum possible.
- * NOTE: This structure requires Double Linked Lists to work.
+ * NOTE: This structure requires Double Linked Lists and POSIX threads to work.
  * NOTE: This structure isn't meant to be indexed, but a series of functions
  * that target specific nodes have been provided. In this implementation, no
  * aliasing problems should arise with such node's pointers during normal
  * maintenance of the structure itself.
  * NOTE: Nodes's contents could be pointers to the heap as well. A binary flag
  * is provided to free them when total heap deletion is called.
+ * NOTE: Nodes can be allocated by the caller and reused, e.g. once returned by
+ * "fhDeleteMin", with "fhInsertNode". In this case, DELETE_KEEP_NODES must be
+ * passed to the delete functions that would free nodes still in the heap.
+ * "fhClear" empties a heap in time proportional to its size, so that it can
+ * be reused instead of being created anew.
+ * NOTE: Bulk deletions ("fhDeleteAbove", "fhDeleteWorst") erase the nodes they
+ * remove, so pointers to such nodes must not be used afterwards.
+ * NOTE: Heaps created with "createPooledFibHeap" take their nodes from a pool,
+ * which is grown in chunks and recycles erased nodes. Such nodes can be
+ * referred to with handles ("fhHandle"), which carry the node's index in the
+ * pool and a generation counter that changes each time the node is recycled
+ * (or put back in the heap with "fhInsertNode").
+ * "fhResolve" validates a handle in constant time, returning NULL if its node
+ * has been erased or isn't in the heap anymore, so stale handles can't alias
+ * new elements. All functions that take a node accept a NULL one, so a
+ * resolved handle can be passed directly to them.
+ * NOTE: Pooled heaps can also keep an index of their elements by ID (e.g. a
+ * vertex number), so that they can be looked up and modified by ID only.
+ * IDs in [0, n) can be direct-mapped to an array of n handles; otherwise, a
+ * hash table with open addressing is used, whose size is proportional to the
+ * number of elements in the heap. "fhDeleteById" removes the entry of its
+ * element, while entries of nodes that leave the heap otherwise are
+ * recognized as stale through their handles, and purged lazily.
+ * NOTE: All keys can be changed at once by a user function with
+ * "fhTransformKeys" (e.g. to age priorities). If the function preserves the
+ * order between nodes, so does the structure; otherwise, the heap is rebuilt
+ * from its nodes in linear time. Nodes are never reallocated in the process.
+ * NOTE: A heap can be switched to a relaxed mode with "fhSetRelaxed", for
+ * applications that can do with an approximate minimum. In this mode, trees
+ * are consolidated only when the roots are more than a given bound, and the
+ * new minimum after a deletion is taken from a few candidate roots, whose
+ * keys were found within a given error of a lower bound on the true minimum
+ * by the last full scan of the roots. Thus, the minimum node and the one
+ * returned by "fhDeleteMin" have a key at most that error greater than the
+ * smallest one in the heap.
+ * NOTE: A heap can be loaded in linear time from keys sorted in ascending
+ * order with "fhBuildFromSorted", which builds binomial trees directly out of
+ * consecutive runs of keys, with no comparisons other than those needed to
+ * check the order (which can be skipped, see BUILD_TRUST_SORTED). Unsorted
+ * input is first sorted with a radix sort, which is linear as well. Pooled
+ * heaps take such nodes from fresh chunks, so that each tree lies
+ * contiguously in memory.
+ * NOTE: "fhPeekSmallest" copies the smallest keys in the heap, and their
+ * elements, without modifying it. It walks the trees from their roots in key
+ * order, so it takes time proportional to the number of roots plus that of
+ * the keys requested (times a logarithmic factor). "fhDeleteMinBatch" deletes
+ * the nodes found in the same way, e.g. to hand one to each of p workers,
+ * with a single consolidation instead of one for each node.
+ * NOTE: Consolidations of many roots (e.g. the first minimum deletion after
+ * lots of insertions) can be split among threads with
+ * "fhSetParallelRebuild": each thread links a slice of the roots into its own
+ * table of trees by order, and the tables are then merged by the calling
+ * thread. The resulting heap is as valid as a sequential rebuild's, though
+ * its trees may be shaped differently.
+ * NOTE: Many operations can be applied at once with "fhApplyBatch". Insertions
+ * deleted later in the same batch never enter the heap, consecutive key
+ * updates on the same node are collapsed into one, and nodes that are deleted
+ * or whose keys are increased are just cut, so that the heap is consolidated
+ * once for the whole batch.
+ * WARNING: Pooled nodes live as long as their heap: nodes deleted from the heap
+ * and not yet erased are invalidated when the heap is erased.
  */
 /* This code is released under the MIT license.
  * See the attached LICENSE file.
@@ -38,10 +99,49 @@
 #include "double-linked-lists_c/DoubleLinkedList/doubleLinkedList.h"
 
 /* These options can be OR'd in a call to the delete functions to specify
- * if also the data in the nodes must be freed in the heap.
+ * if also the data in the nodes must be freed in the heap, or if the nodes
+ * must be left alone since their memory is managed by the caller (see
+ * "fhInsertNode").
  * If nothing is specified, only the nodes are freed.
  */
 #define DELETE_FREE_DATA 0x1
+#define DELETE_KEEP_NODES 0x2
+
+/* This option can be passed to "fhBuildFromSorted" to skip the check of the
+ * order of the keys, which must then be sorted for sure.
+ */
+#define BUILD_TRUST_SORTED 0x1
+
+/* Node pools are grown in chunks of 2^FH_POOL_CHUNK_ORD nodes. */
+#define FH_POOL_CHUNK_ORD 10
+
+/* Initial size of sparse element ID indexes (must be a power of 2). */
+#define FH_INDEX_INIT_SIZE 64
+
+/* Maximum number of candidate minimums kept in relaxed mode. */
+#define FH_RELAX_CANDS 64
+
+/* Default minimum number of roots for a consolidation to be parallel. */
+#define FH_PARALLEL_MIN_ROOTS 65536
+
+/* Types of operations in a batch (see "fhApplyBatch"). */
+#define FH_OP_INSERT 0
+#define FH_OP_DECREASE 1
+#define FH_OP_INCREASE 2
+#define FH_OP_DELETE 3
+
+/* Outcomes of operations in a batch: applied to the heap, elided (i.e.
+ * cancelled by, or folded into, another operation of the batch), or failed.
+ */
+#define FH_OP_DONE 0
+#define FH_OP_ELIDED 1
+#define FH_OP_FAILED -1
+
+/* Handle to a pooled node: generation in the upper 32 bits, index in the pool
+ * in the lower ones. Generations start from 1, so no handle is 0.
+ */
+typedef uint64_t FibHandle;
+#define FH_NULL_HANDLE 0
 
 /* Fibonacci Tree Node.
  * Stores a key, an element, and other metadata needed to keep track of the
@@ -56,14 +156,44 @@ typedef struct __fibTreeNode {
     struct __fibTreeNode *_prevBro;  // Pointer to the previous brother.
     Record *_posInForest;            // For roots, position in a forest list.
     ulong _sonsCnt;                  // Counter for a node' sons.
+    struct __fibNodePool *_pool;     // Pool the node belongs to, if any.
+    uint32_t _poolIdx;               // Index of the node in its pool.
+    uint32_t _gen;                   // Generation of the node in its pool.
     unsigned char _grief;            // Indicates the loss of a son.
 } FibTreeNode;
 
+/* Fibonacci Tree Nodes Pool. Nodes are allocated in chunks, which are never
+ * moved, so that nodes can be found by index. Erased nodes are kept in a free
+ * list, linked through their "_nextBro" field.
+ */
+typedef struct __fibNodePool {
+    FibTreeNode **_chunks;           // Arrays of nodes.
+    ulong _chunksCnt;
+    ulong _used;                     // Nodes taken from chunks so far.
+    FibTreeNode *_freeList;          // Erased nodes, ready to be reused.
+} FibNodePool;
+
 /* Fibonacci Tree. Stores a pointer to its root node. */
 typedef struct {
     FibTreeNode *_root;
 } FibTree;
 
+/* Element ID index entry, for sparse IDs. */
+typedef struct {
+    uint64_t id;
+    FibHandle handle;                // FH_NULL_HANDLE for empty entries.
+} FibIndexEntry;
+
+/* Element ID index. Either direct-mapped handles for dense IDs, or a linear
+ * probing hash table of (ID, handle) pairs for sparse IDs.
+ */
+typedef struct {
+    FibHandle *_handles;             // Dense index (NULL if sparse).
+    FibIndexEntry *_entries;         // Sparse index (NULL if dense).
+    ulong _size;                     // IDs, or entries (a power of 2).
+    ulong _used;                     // Sparse index only: busy entries.
+} FibIndex;
+
 /* Fibonacci Heap. Keeps a pointer to its minimum-key node (and some
  * metadata to better track it). The "forest" is seen as an array of dynamic
  * lists, which contain pointers to trees of a specific order.
@@ -73,18 +203,64 @@ typedef struct {
     FibTreeNode *min;         // Pointer to minimum key node.
     ulong _maxTreeOrd;        // Maximum size for a tree (changes if needed).
     ulong nodesCount;         // Counter for the nodes in the structure.
+    FibNodePool *_pool;       // Nodes pool, if the heap uses one.
+    FibIndex *_index;         // Element ID index, if enabled.
+    ulong _relaxRoots;        // Relaxed mode: roots bound (0 if exact).
+    uint64_t _relaxEps;       // Relaxed mode: admitted key error.
+    uint64_t _lowBound;       // Lower bound on the smallest key.
+    FibTreeNode **_relaxCands; // Relaxed mode: candidate minimums.
+    ulong _relaxCandsCnt;
+    ulong _rebuildThreads;    // Threads for consolidations (1 if serial).
+    ulong _rebuildMinRoots;   // Roots that make consolidations parallel.
 } FibHeap;
 
+/* Operation in a batch. Decreases, increases and deletions target either a
+ * node, or (if node is NULL) the insertion at index ref in the same batch.
+ * Upon return, node holds the node inserted or deleted by the operation, if
+ * any, and status its outcome.
+ */
+typedef struct {
+    int type;
+    int status;
+    uint64_t key;             // Insertions: key. Updates: key delta.
+    void *elem;               // Insertions only.
+    FibTreeNode *node;
+    ulong ref;
+} FibOp;
+
 /* Library functions. */
 FibHeap *createFibHeap(ulong initMaxTreeOrd);
+FibHeap *createPooledFibHeap(ulong initMaxTreeOrd);
 void eraseFibHeap(FibHeap *heap, int opts);
 void eraseFibTreeNode(FibTreeNode *node, int opts);
 int isHeapEmpty(FibHeap *heap);
 FibTreeNode *fhInsert(FibHeap *heap, void *elem, uint64_t key);
+FibTreeNode *fhInsertNode(FibHeap *heap, FibTreeNode *node, uint64_t key);
+void fhClear(FibHeap *heap, int opts);
+int fhBuildFromSorted(FibHeap *heap, uint64_t *keys, void **elems, ulong n,
+                      int opts);
+FibHandle fhHandle(FibTreeNode *node);
+FibTreeNode *fhResolve(FibHeap *heap, FibHandle handle);
+int fhEnableIndex(FibHeap *heap, ulong denseIds);
+FibTreeNode *fhInsertWithId(FibHeap *heap, void *elem, uint64_t key,
+                            uint64_t id);
+FibTreeNode *fhFindById(FibHeap *heap, uint64_t id);
+int fhContains(FibHeap *heap, uint64_t id);
+FibTreeNode *fhDecreaseKeyById(FibHeap *heap, uint64_t id, uint64_t dec);
+FibTreeNode *fhDeleteById(FibHeap *heap, uint64_t id);
+int fhTransformKeys(FibHeap *heap, uint64_t (*fn)(uint64_t key, void *ctx),
+                    void *ctx);
+int fhSetRelaxed(FibHeap *heap, ulong maxRoots, uint64_t eps);
+int fhSetParallelRebuild(FibHeap *heap, ulong threadsCnt, ulong minRoots);
 void *fhFindMin(FibHeap *heap);
+ulong fhPeekSmallest(FibHeap *heap, ulong n, uint64_t *keys, void **elems);
 FibTreeNode *fhDecreaseKey(FibHeap *heap, FibTreeNode *node, uint64_t dec);
 FibTreeNode *fhDeleteMin(FibHeap *heap);
+ulong fhDeleteMinBatch(FibHeap *heap, ulong p, FibTreeNode **nodes);
 FibTreeNode *fhDelete(FibHeap *heap, FibTreeNode *node);
 FibTreeNode *fhIncreaseKey(FibHeap *heap, FibTreeNode *node, uint64_t inc);
+ulong fhDeleteAbove(FibHeap *heap, uint64_t threshold, int opts);
+ulong fhDeleteWorst(FibHeap *heap, ulong count, int opts);
+int fhApplyBatch(FibHeap *heap, FibOp *ops, ulong n);
 
 #endif
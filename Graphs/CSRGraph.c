@@ -0,0 +1,201 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the CSR Graph library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "CSRGraph.h"
+
+/* Declarations of internal library subroutines. */
+uint64_t _csrAlign(uint64_t pos);
+int _csrWriteAt(FILE *file, uint64_t pos, const void *data, size_t size,
+                size_t count);
+int _csrFits(uint64_t pos, size_t size, uint64_t count, size_t fileSize);
+
+// LIBRARY FUNCTIONS //
+/* Creates a new CSR Graph from an edge list, given as three arrays.
+ * Edges keep their relative order in the adjacency of each vertex.
+ * Weights may be NULL, in which case all edges weigh 1.
+ */
+CSRGraph *createCSRGraph(ulong verticesCount, ulong edgesCount,
+                         const uint32_t *sources, const uint32_t *targets,
+                         const uint32_t *weights) {
+    if ((verticesCount == 0) || (verticesCount > ((ulong)UINT32_MAX + 1)))
+        return NULL;
+    if ((edgesCount > 0) && ((sources == NULL) || (targets == NULL)))
+        return NULL;
+    CSRGraph *newGraph = calloc(1, sizeof(CSRGraph));
+    if (newGraph == NULL) return NULL;
+    newGraph->offsets = calloc(verticesCount + 1, sizeof(uint64_t));
+    newGraph->targets = calloc(edgesCount + 1, sizeof(uint32_t));
+    newGraph->weights = calloc(edgesCount + 1, sizeof(uint32_t));
+    if ((newGraph->offsets == NULL) || (newGraph->targets == NULL) ||
+        (newGraph->weights == NULL)) {
+        eraseCSRGraph(newGraph);
+        return NULL;
+    }
+    newGraph->verticesCount = verticesCount;
+    newGraph->edgesCount = edgesCount;
+
+    // Count out-degrees, then turn counters into offsets.
+    for (ulong i = 0; i < edgesCount; i++) {
+        if ((sources[i] >= verticesCount) || (targets[i] >= verticesCount)) {
+            eraseCSRGraph(newGraph);
+            return NULL;
+        }
+        newGraph->offsets[sources[i] + 1]++;
+    }
+    for (ulong v = 0; v < verticesCount; v++)
+        newGraph->offsets[v + 1] += newGraph->offsets[v];
+
+    // Place edges, using the offsets as insertion points for a while.
+    for (ulong i = 0; i < edgesCount; i++) {
+        uint64_t pos = newGraph->offsets[sources[i]]++;
+        newGraph->targets[pos] = targets[i];
+        newGraph->weights[pos] = weights != NULL ? weights[i] : 1;
+    }
+    for (ulong v = verticesCount; v > 0; v--)
+        newGraph->offsets[v] = newGraph->offsets[v - 1];
+    newGraph->offsets[0] = 0;
+    return newGraph;
+}
+
+/* Destroys a CSR Graph, freeing memory (or unmapping its file). */
+void eraseCSRGraph(CSRGraph *graph) {
+    if (graph == NULL) return;
+    if (graph->_mapping != NULL) {
+        munmap(graph->_mapping, graph->_mappingSize);
+    } else {
+        free(graph->offsets);
+        free(graph->targets);
+        free(graph->weights);
+    }
+    free(graph);
+}
+
+/* Returns the maximum edge weight in a graph (0 if it has no edges). */
+uint32_t csrMaxWeight(CSRGraph *graph) {
+    if (graph == NULL) return 0;
+    uint32_t maxWeight = 0;
+    for (ulong i = 0; i < graph->edgesCount; i++)
+        if (graph->weights[i] > maxWeight) maxWeight = graph->weights[i];
+    return maxWeight;
+}
+
+/* Saves a CSR Graph to a binary file, which is overwritten if it exists.
+ * Returns 0 on success, -1 on failure.
+ */
+int csrSave(CSRGraph *graph, const char *path) {
+    if ((graph == NULL) || (path == NULL)) return -1;
+    CSRFileHeader header = {0};
+    header.magic = CSR_FILE_MAGIC;
+    header.verticesCount = graph->verticesCount;
+    header.edgesCount = graph->edgesCount;
+    header.offsetsPos = _csrAlign(sizeof(CSRFileHeader));
+    header.targetsPos = _csrAlign(header.offsetsPos +
+                                  ((graph->verticesCount + 1) *
+                                   sizeof(uint64_t)));
+    header.weightsPos = _csrAlign(header.targetsPos +
+                                  (graph->edgesCount * sizeof(uint32_t)));
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return -1;
+    int ret = 0;
+    if (_csrWriteAt(file, 0, &header, sizeof(CSRFileHeader), 1) ||
+        _csrWriteAt(file, header.offsetsPos, graph->offsets, sizeof(uint64_t),
+                    graph->verticesCount + 1) ||
+        _csrWriteAt(file, header.targetsPos, graph->targets, sizeof(uint32_t),
+                    graph->edgesCount) ||
+        _csrWriteAt(file, header.weightsPos, graph->weights, sizeof(uint32_t),
+                    graph->edgesCount))
+        ret = -1;
+    if (fclose(file) != 0) ret = -1;
+    return ret;
+}
+
+/* Loads a CSR Graph from a binary file, mapping it in memory.
+ * The file is checked for consistency, but not for well-formedness of its
+ * contents (e.g. target vertices are not checked).
+ */
+CSRGraph *csrLoad(const char *path) {
+    if (path == NULL) return NULL;
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) return NULL;
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) == -1) ||
+        ((size_t)fileStat.st_size < sizeof(CSRFileHeader))) {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)fileStat.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file open.
+    if (mapping == MAP_FAILED) return NULL;
+
+    // Check that the header and the arrays fit the file.
+    CSRFileHeader *header = (CSRFileHeader *)mapping;
+    uint64_t n = header->verticesCount, m = header->edgesCount;
+    if ((header->magic != CSR_FILE_MAGIC) || (n == 0) ||
+        (n > ((uint64_t)UINT32_MAX + 1)) ||
+        (header->offsetsPos % 8) || (header->targetsPos % 8) ||
+        (header->weightsPos % 8) ||
+        !_csrFits(header->offsetsPos, sizeof(uint64_t), n + 1, size) ||
+        !_csrFits(header->targetsPos, sizeof(uint32_t), m, size) ||
+        !_csrFits(header->weightsPos, sizeof(uint32_t), m, size)) {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    CSRGraph *newGraph = calloc(1, sizeof(CSRGraph));
+    if (newGraph == NULL) {
+        munmap(mapping, size);
+        return NULL;
+    }
+    char *base = (char *)mapping;
+    newGraph->offsets = (uint64_t *)(base + header->offsetsPos);
+    newGraph->targets = (uint32_t *)(base + header->targetsPos);
+    newGraph->weights = (uint32_t *)(base + header->weightsPos);
+    newGraph->verticesCount = n;
+    newGraph->edgesCount = m;
+    newGraph->_mapping = mapping;
+    newGraph->_mappingSize = size;
+    if (newGraph->offsets[n] != m) {
+        eraseCSRGraph(newGraph);
+        return NULL;
+    }
+    return newGraph;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Rounds a file position up to a multiple of 8. */
+uint64_t _csrAlign(uint64_t pos) {
+    return (pos + 7) & ~((uint64_t)7);
+}
+
+/* Writes an array at a given position of a file.
+ * Returns 0 on success, -1 on failure.
+ */
+int _csrWriteAt(FILE *file, uint64_t pos, const void *data, size_t size,
+                size_t count) {
+    if (fseeko(file, (off_t)pos, SEEK_SET) != 0) return -1;
+    if (count == 0) return 0;
+    return fwrite(data, size, count, file) == count ? 0 : -1;
+}
+
+/* Tells whether an array fits in a file at a given position. */
+int _csrFits(uint64_t pos, size_t size, uint64_t count, size_t fileSize) {
+    if (count == 0) return 1;
+    return (pos <= fileSize) && (((fileSize - pos) / size) >= count);
+}
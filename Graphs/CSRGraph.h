@@ -0,0 +1,64 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the CSR Graph
+ * library, which stores static directed graphs in Compressed Sparse Row form:
+ * the edges leaving vertex v are stored, in order, in positions
+ * [offsets[v], offsets[v + 1]) of the targets and weights arrays.
+ * This is the graph representation used by the shortest paths modules in this
+ * directory. Vertices are numbered from 0, and edge weights are unsigned
+ * 32-bit integers, so that path lengths always fit in 64 bits.
+ * Graphs can be saved to binary files, which hold the three arrays as they
+ * are in memory, and loaded back by mapping such files in memory: no parsing
+ * or copying takes place, and pages are read from disk only when accessed.
+ * The "csrconvert" program converts text graph files to this format.
+ * NOTE: Undirected graphs must be stored with both directions of each edge.
+ * NOTE: Graphs loaded from files are read-only: their arrays must not be
+ * written to.
+ * NOTE: Binary files use the byte order of the machine that wrote them.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Magic number of CSR Graph files ("FHCSRv1\0"). */
+#define CSR_FILE_MAGIC 0x0031764352534846ULL
+
+/* CSR Graph file header. Arrays follow, at 8-byte-aligned offsets. */
+typedef struct {
+    uint64_t magic;
+    uint64_t verticesCount;
+    uint64_t edgesCount;
+    uint64_t offsetsPos;    // File offset of the offsets array.
+    uint64_t targetsPos;    // File offset of the targets array.
+    uint64_t weightsPos;    // File offset of the weights array.
+    uint64_t _reserved[2];
+} CSRFileHeader;
+
+/* CSR Graph. Arrays are meant to be read directly by graph algorithms. */
+typedef struct {
+    uint64_t *offsets;      // First edge of each vertex (verticesCount + 1).
+    uint32_t *targets;      // Edge targets.
+    uint32_t *weights;      // Edge weights.
+    ulong verticesCount;
+    ulong edgesCount;
+    void *_mapping;         // File mapping, for loaded graphs.
+    size_t _mappingSize;
+} CSRGraph;
+
+/* Library functions. */
+CSRGraph *createCSRGraph(ulong verticesCount, ulong edgesCount,
+                         const uint32_t *sources, const uint32_t *targets,
+                         const uint32_t *weights);
+void eraseCSRGraph(CSRGraph *graph);
+uint32_t csrMaxWeight(CSRGraph *graph);
+int csrSave(CSRGraph *graph, const char *path);
+CSRGraph *csrLoad(const char *path);
+
+#endif
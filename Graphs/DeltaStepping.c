@@ -0,0 +1,325 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Delta Stepping library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "DeltaStepping.h"
+
+/* Dynamic array of vertices. */
+typedef struct {
+    uint32_t *data;
+    ulong size;
+    ulong cap;
+} DSVector;
+
+/* Per-thread data. Outboxes hold relaxed vertices owned by other threads. */
+typedef struct {
+    DSVector *buckets;        // Cyclic array of buckets.
+    DSVector frontier;        // Vertices being taken from the current bucket.
+    DSVector removed;         // Vertices removed from the current bucket.
+    DSVector *outboxes;       // Relaxed vertices, for each owner thread.
+    uint64_t minBucket;       // Local minimum nonempty bucket.
+    int busy;                 // Set if the current bucket is not empty.
+} DSThread;
+
+/* Shared search state. Per-vertex markers are only used by owner threads. */
+typedef struct {
+    CSRGraph *graph;
+    uint64_t *dist;
+    uint64_t delta;
+    ulong bucketsCnt;
+    ulong threadsCnt;
+    DSThread *threads;
+    uint64_t *relaxedAt;      // Distance at which a vertex was last relaxed.
+    uint64_t *removedFrom;    // Bucket a vertex was last removed from (+1).
+    pthread_barrier_t barrier;
+    pthread_mutex_t startLock;
+    pthread_cond_t startCond;
+    int started;              // Set when all threads have been created.
+    int failed;
+} DSSearch;
+
+/* Worker thread argument. */
+typedef struct {
+    DSSearch *search;
+    ulong id;
+} DSWorkerArg;
+
+/* Declarations of internal library subroutines. */
+int _dsPush(DSVector *vec, uint32_t v);
+void *_dsWorker(void *arg);
+void _dsRelax(DSSearch *search, DSThread *self, ulong u, int heavy);
+void _dsCollect(DSSearch *search, ulong id);
+void _dsFail(DSSearch *search);
+void _dsEraseThreads(DSSearch *search);
+
+// LIBRARY FUNCTIONS //
+/* Computes the distances of all vertices from a source vertex, storing them
+ * in an array of verticesCount entries. If delta is 0, it is chosen as the
+ * maximum weight divided by the average degree.
+ * Returns 0 on success, -1 on failure.
+ */
+int deltaStepping(CSRGraph *graph, ulong source, uint64_t delta,
+                  ulong threads, uint64_t *dist) {
+    if ((graph == NULL) || (dist == NULL)) return -1;
+    if (source >= graph->verticesCount) return -1;
+    ulong verticesCount = graph->verticesCount;
+
+    // Choose the buckets' width.
+    uint64_t maxWeight = csrMaxWeight(graph);
+    if (delta == 0) {
+        ulong avgDegree = graph->edgesCount / verticesCount;
+        delta = maxWeight / (avgDegree > 0 ? avgDegree : 1);
+    }
+    if (delta == 0) delta = 1;
+    if ((maxWeight / delta) + 2 > DS_MAX_BUCKETS)
+        delta = (maxWeight / (DS_MAX_BUCKETS - 2)) + 1;
+
+    DSSearch search;
+    search.graph = graph;
+    search.dist = dist;
+    search.delta = delta;
+    search.bucketsCnt = (maxWeight / delta) + 2;
+    search.threadsCnt = threads > 1 ? threads : 1;
+    search.failed = 0;
+    search.threads = calloc(search.threadsCnt, sizeof(DSThread));
+    search.relaxedAt = calloc(verticesCount, sizeof(uint64_t));
+    search.removedFrom = calloc(verticesCount, sizeof(uint64_t));
+    if ((search.threads == NULL) || (search.relaxedAt == NULL) ||
+        (search.removedFrom == NULL)) {
+        _dsEraseThreads(&search);
+        return -1;
+    }
+    for (ulong i = 0; i < search.threadsCnt; i++) {
+        search.threads[i].buckets = calloc(search.bucketsCnt, sizeof(DSVector));
+        search.threads[i].outboxes = calloc(search.threadsCnt,
+                                            sizeof(DSVector));
+        if ((search.threads[i].buckets == NULL) ||
+            (search.threads[i].outboxes == NULL)) {
+            _dsEraseThreads(&search);
+            return -1;
+        }
+    }
+    for (ulong v = 0; v < verticesCount; v++) {
+        dist[v] = UINT64_MAX;
+        search.relaxedAt[v] = UINT64_MAX;
+    }
+    dist[source] = 0;
+    if (!_dsPush(&(search.threads[source % search.threadsCnt].buckets[0]),
+                 (uint32_t)source)) {
+        _dsEraseThreads(&search);
+        return -1;
+    }
+
+    // Start the workers, the calling thread included.
+    DSWorkerArg *args = calloc(search.threadsCnt, sizeof(DSWorkerArg));
+    pthread_t *workers = calloc(search.threadsCnt, sizeof(pthread_t));
+    if ((args == NULL) || (workers == NULL)) {
+        free(args);
+        free(workers);
+        _dsEraseThreads(&search);
+        return -1;
+    }
+    // Threads wait for each other on barriers, so they can't start until
+    // it's known how many of them there are.
+    pthread_mutex_init(&(search.startLock), NULL);
+    pthread_cond_init(&(search.startCond), NULL);
+    search.started = 0;
+    ulong started = 1;
+    for (ulong i = 1; i < search.threadsCnt; i++) {
+        args[i].search = &search;
+        args[i].id = i;
+        if (pthread_create(&(workers[i]), NULL, _dsWorker, &(args[i]))) break;
+        started++;
+    }
+    // If some are missing, the ones we got just stop at the first bucket.
+    if (started < search.threadsCnt) search.failed = 1;
+    pthread_barrier_init(&(search.barrier), NULL, (unsigned)started);
+    pthread_mutex_lock(&(search.startLock));
+    search.started = 1;
+    pthread_cond_broadcast(&(search.startCond));
+    pthread_mutex_unlock(&(search.startLock));
+    args[0].search = &search;
+    args[0].id = 0;
+    _dsWorker(&(args[0]));
+    for (ulong i = 1; i < started; i++) pthread_join(workers[i], NULL);
+    pthread_barrier_destroy(&(search.barrier));
+    pthread_cond_destroy(&(search.startCond));
+    pthread_mutex_destroy(&(search.startLock));
+
+    int ret = search.failed ? -1 : 0;
+    free(args);
+    free(workers);
+    _dsEraseThreads(&search);
+    return ret;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Appends a vertex to a dynamic array. Returns 1 on success, 0 on failure. */
+int _dsPush(DSVector *vec, uint32_t v) {
+    if (vec->size == vec->cap) {
+        ulong newCap = vec->cap > 0 ? vec->cap * 2 : 16;
+        uint32_t *newData = reallocarray(vec->data, newCap, sizeof(uint32_t));
+        if (newData == NULL) return 0;
+        vec->data = newData;
+        vec->cap = newCap;
+    }
+    vec->data[vec->size++] = v;
+    return 1;
+}
+
+/* Marks the search as failed. All threads stop at the next bucket. */
+void _dsFail(DSSearch *search) {
+    __atomic_store_n(&(search->failed), 1, __ATOMIC_RELAXED);
+}
+
+/* Worker thread routine. Threads proceed in lockstep, one bucket at a time,
+ * synchronizing on a barrier between phases.
+ */
+void *_dsWorker(void *arg) {
+    DSSearch *search = ((DSWorkerArg *)arg)->search;
+    ulong id = ((DSWorkerArg *)arg)->id;
+    DSThread *self = &(search->threads[id]);
+    uint64_t current = 0;
+
+    pthread_mutex_lock(&(search->startLock));
+    while (!(search->started))
+        pthread_cond_wait(&(search->startCond), &(search->startLock));
+    pthread_mutex_unlock(&(search->startLock));
+
+    while (1) {
+        // Find the first nonempty bucket, locally and then globally.
+        self->minBucket = UINT64_MAX;
+        for (ulong i = 0; i < search->bucketsCnt; i++) {
+            if (self->buckets[(current + i) % search->bucketsCnt].size > 0) {
+                self->minBucket = current + i;
+                break;
+            }
+        }
+        pthread_barrier_wait(&(search->barrier));
+        uint64_t globalMin = UINT64_MAX;
+        for (ulong i = 0; i < search->threadsCnt; i++)
+            if (search->threads[i].minBucket < globalMin)
+                globalMin = search->threads[i].minBucket;
+        int failed = __atomic_load_n(&(search->failed), __ATOMIC_RELAXED);
+        pthread_barrier_wait(&(search->barrier));
+        if ((globalMin == UINT64_MAX) || failed) break;
+        current = globalMin;
+        self->removed.size = 0;
+
+        // Light phase: empty the bucket until no thread refills it.
+        while (1) {
+            DSVector *bucket = &(self->buckets[current % search->bucketsCnt]);
+            DSVector tmp = self->frontier;
+            self->frontier = *bucket;
+            *bucket = tmp;
+            bucket->size = 0;
+            for (ulong i = 0; i < self->frontier.size; i++) {
+                ulong u = self->frontier.data[i];
+                uint64_t d = __atomic_load_n(&(search->dist[u]),
+                                             __ATOMIC_RELAXED);
+                // Skip stale entries, and vertices already relaxed at this
+                // distance.
+                if (((d / search->delta) != current) ||
+                    (search->relaxedAt[u] == d)) continue;
+                search->relaxedAt[u] = d;
+                if (search->removedFrom[u] != current + 1) {
+                    search->removedFrom[u] = current + 1;
+                    if (!_dsPush(&(self->removed), (uint32_t)u))
+                        _dsFail(search);
+                }
+                _dsRelax(search, self, u, 0);
+            }
+            pthread_barrier_wait(&(search->barrier));
+            _dsCollect(search, id);
+            self->busy =
+                self->buckets[current % search->bucketsCnt].size > 0;
+            pthread_barrier_wait(&(search->barrier));
+            int busy = 0;
+            for (ulong i = 0; i < search->threadsCnt; i++)
+                busy |= search->threads[i].busy;
+            if (!busy) break;
+        }
+
+        // Heavy phase: distances in the bucket are final now.
+        for (ulong i = 0; i < self->removed.size; i++)
+            _dsRelax(search, self, self->removed.data[i], 1);
+        pthread_barrier_wait(&(search->barrier));
+        _dsCollect(search, id);
+    }
+    return NULL;
+}
+
+/* Relaxes either the light or the heavy edges of a vertex, sending each
+ * improved vertex to its owner.
+ */
+void _dsRelax(DSSearch *search, DSThread *self, ulong u, int heavy) {
+    CSRGraph *graph = search->graph;
+    uint64_t d = __atomic_load_n(&(search->dist[u]), __ATOMIC_RELAXED);
+    for (uint64_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+        uint64_t w = graph->weights[e];
+        if ((w > search->delta) != heavy) continue;
+        ulong v = graph->targets[e];
+        uint64_t newDist = d + w;
+        uint64_t oldDist = __atomic_load_n(&(search->dist[v]),
+                                           __ATOMIC_RELAXED);
+        while (newDist < oldDist) {
+            if (__atomic_compare_exchange_n(&(search->dist[v]), &oldDist,
+                                            newDist, 1, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                if (!_dsPush(&(self->outboxes[v % search->threadsCnt]),
+                             (uint32_t)v))
+                    _dsFail(search);
+                break;
+            }
+        }
+    }
+}
+
+/* Files the vertices sent to a thread by all threads in its buckets. */
+void _dsCollect(DSSearch *search, ulong id) {
+    DSThread *self = &(search->threads[id]);
+    for (ulong i = 0; i < search->threadsCnt; i++) {
+        DSVector *inbox = &(search->threads[i].outboxes[id]);
+        for (ulong j = 0; j < inbox->size; j++) {
+            ulong v = inbox->data[j];
+            uint64_t b = __atomic_load_n(&(search->dist[v]),
+                                         __ATOMIC_RELAXED) / search->delta;
+            if (!_dsPush(&(self->buckets[b % search->bucketsCnt]),
+                         (uint32_t)v))
+                _dsFail(search);
+        }
+        inbox->size = 0;
+    }
+}
+
+/* Frees all search data. */
+void _dsEraseThreads(DSSearch *search) {
+    if (search->threads != NULL) {
+        for (ulong i = 0; i < search->threadsCnt; i++) {
+            DSThread *thread = &(search->threads[i]);
+            if (thread->buckets != NULL)
+                for (ulong j = 0; j < search->bucketsCnt; j++)
+                    free(thread->buckets[j].data);
+            if (thread->outboxes != NULL)
+                for (ulong j = 0; j < search->threadsCnt; j++)
+                    free(thread->outboxes[j].data);
+            free(thread->buckets);
+            free(thread->outboxes);
+            free(thread->frontier.data);
+            free(thread->removed.data);
+        }
+    }
+    free(search->threads);
+    free(search->relaxedAt);
+    free(search->removedFrom);
+}
@@ -0,0 +1,39 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains declarations for the Delta Stepping library, which
+ * computes single-source shortest paths on CSR Graphs in parallel, with the
+ * Delta Stepping algorithm by Meyer and Sanders.
+ * Tentative distances are kept in buckets of width delta: the minimum nonempty
+ * bucket is emptied by relaxing light edges (weight <= delta) until it stays
+ * empty, then heavy edges of all vertices removed from it are relaxed once.
+ * Vertices are partitioned among threads, each of which owns the buckets of
+ * its vertices. Relaxations are performed by any thread, with atomic updates
+ * of distances, and are sent to the owner of the target vertex, which files
+ * it in its buckets after the next synchronization.
+ * Distances of unreachable vertices are set to UINT64_MAX.
+ * NOTE: Distances are updated with GNU C atomic builtins, and threads are
+ * POSIX threads.
+ * NOTE: Each thread keeps a cyclic array of (maxWeight / delta + 2) buckets;
+ * delta is raised if that would exceed DS_MAX_BUCKETS.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef DELTASTEPPING_H
+#define DELTASTEPPING_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "CSRGraph.h"
+
+/* Maximum number of buckets for each thread. */
+#define DS_MAX_BUCKETS 65536
+
+/* Library functions. */
+int deltaStepping(CSRGraph *graph, ulong source, uint64_t delta,
+                  ulong threads, uint64_t *dist);
+
+#endif
@@ -0,0 +1,158 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Dijkstra library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Dijkstra.h"
+
+/* Vertex state flags in a workspace. */
+#define DIJKSTRA_UNREACHED 0x0
+#define DIJKSTRA_QUEUED 0x1
+#define DIJKSTRA_SETTLED 0x2
+#define DIJKSTRA_TARGET 0x4
+
+/* Declarations of internal library subroutines. */
+void _dijkstraTouch(DijkstraWorkspace *ws, ulong v, unsigned char flag);
+void _dijkstraReset(DijkstraWorkspace *ws);
+
+// LIBRARY FUNCTIONS //
+/* Creates a new workspace for graphs with a given number of vertices. */
+DijkstraWorkspace *createDijkstraWorkspace(ulong verticesCount) {
+    if (verticesCount == 0) return NULL;
+    DijkstraWorkspace *newWs = calloc(1, sizeof(DijkstraWorkspace));
+    if (newWs == NULL) return NULL;
+    ulong treeOrd = 1;
+    while ((1UL << treeOrd) < verticesCount) treeOrd++;
+    newWs->_heap = createFibHeap(treeOrd + 1);
+    newWs->_nodes = calloc(verticesCount, sizeof(FibTreeNode));
+    newWs->_state = calloc(verticesCount, sizeof(unsigned char));
+    newWs->_touched = calloc(verticesCount, sizeof(uint32_t));
+    newWs->dist = calloc(verticesCount, sizeof(uint64_t));
+    if ((newWs->_heap == NULL) || (newWs->_nodes == NULL) ||
+        (newWs->_state == NULL) || (newWs->_touched == NULL) ||
+        (newWs->dist == NULL)) {
+        eraseDijkstraWorkspace(newWs);
+        return NULL;
+    }
+    for (ulong v = 0; v < verticesCount; v++) {
+        newWs->_nodes[v].elem = (void *)v;
+        newWs->dist[v] = UINT64_MAX;
+    }
+    newWs->_touchedCnt = 0;
+    newWs->verticesCount = verticesCount;
+    return newWs;
+}
+
+/* Destroys a workspace, freeing memory. */
+void eraseDijkstraWorkspace(DijkstraWorkspace *ws) {
+    if (ws == NULL) return;
+    // Nodes live in their own array.
+    eraseFibHeap(ws->_heap, DELETE_KEEP_NODES);
+    free(ws->_nodes);
+    free(ws->_state);
+    free(ws->_touched);
+    free(ws->dist);
+    free(ws);
+}
+
+/* Computes the distances of vertices from a source vertex in a workspace.
+ * If targets are given, the search stops once all of them are settled, and
+ * only their distances are exact: those of other vertices may be exact (if
+ * settled), upper bounds (if still in the heap), or UINT64_MAX (if never
+ * reached).
+ * Returns 0 on success, -1 on failure.
+ */
+int dijkstraSearch(DijkstraWorkspace *ws, CSRGraph *graph, ulong source,
+                   const uint32_t *targets, ulong targetsCnt) {
+    if ((ws == NULL) || (graph == NULL)) return -1;
+    if ((graph->verticesCount != ws->verticesCount) ||
+        (source >= ws->verticesCount)) return -1;
+    if ((targetsCnt > 0) && (targets == NULL)) return -1;
+    _dijkstraReset(ws);
+
+    // Mark targets, counting each one once.
+    ulong targetsLeft = 0;
+    for (ulong i = 0; i < targetsCnt; i++) {
+        if (targets[i] >= ws->verticesCount) return -1;
+        if (!(ws->_state[targets[i]] & DIJKSTRA_TARGET)) {
+            _dijkstraTouch(ws, targets[i], DIJKSTRA_TARGET);
+            targetsLeft++;
+        }
+    }
+
+    ws->dist[source] = 0;
+    _dijkstraTouch(ws, source, DIJKSTRA_QUEUED);
+    if (fhInsertNode(ws->_heap, &(ws->_nodes[source]), 0) == NULL) return -1;
+
+    int ret = 0;
+    while (ws->_heap->min != NULL) {
+        // The minimum is settled: relax its edges.
+        FibTreeNode *minNode = fhDeleteMin(ws->_heap);
+        ulong u = (ulong)minNode->elem;
+        ws->_state[u] = (ws->_state[u] & DIJKSTRA_TARGET) | DIJKSTRA_SETTLED;
+        if ((ws->_state[u] & DIJKSTRA_TARGET) && (--targetsLeft == 0)) break;
+        for (uint64_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            ulong v = graph->targets[e];
+            uint64_t newDist = ws->dist[u] + graph->weights[e];
+            if (newDist >= ws->dist[v]) continue;
+            if (ws->_state[v] & DIJKSTRA_QUEUED) {
+                fhDecreaseKey(ws->_heap, &(ws->_nodes[v]),
+                              ws->dist[v] - newDist);
+            } else {
+                // Never reached before, since settled vertices can't improve.
+                if (fhInsertNode(ws->_heap, &(ws->_nodes[v]), newDist) ==
+                    NULL) {
+                    ret = -1;
+                    continue;
+                }
+                _dijkstraTouch(ws, v, DIJKSTRA_QUEUED);
+            }
+            ws->dist[v] = newDist;
+        }
+    }
+    return ret;
+}
+
+/* Computes the distances of all vertices from a source vertex, storing them
+ * in an array of verticesCount entries. Uses a temporary workspace.
+ * Returns 0 on success, -1 on failure.
+ */
+int dijkstra(CSRGraph *graph, ulong source, uint64_t *dist) {
+    if ((graph == NULL) || (dist == NULL)) return -1;
+    DijkstraWorkspace *ws = createDijkstraWorkspace(graph->verticesCount);
+    if (ws == NULL) return -1;
+    int ret = dijkstraSearch(ws, graph, source, NULL, 0);
+    memcpy(dist, ws->dist, graph->verticesCount * sizeof(uint64_t));
+    eraseDijkstraWorkspace(ws);
+    return ret;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Sets a state flag of a vertex, remembering that it must be reset. */
+void _dijkstraTouch(DijkstraWorkspace *ws, ulong v, unsigned char flag) {
+    if (ws->_state[v] == DIJKSTRA_UNREACHED)
+        ws->_touched[ws->_touchedCnt++] = (uint32_t)v;
+    ws->_state[v] |= flag;
+}
+
+/* Resets a workspace after a search, in time proportional to the number of
+ * vertices it reached.
+ */
+void _dijkstraReset(DijkstraWorkspace *ws) {
+    // Nodes still in the heap (after an early stop) are just detached.
+    fhClear(ws->_heap, DELETE_KEEP_NODES);
+    for (ulong i = 0; i < ws->_touchedCnt; i++) {
+        ws->_state[ws->_touched[i]] = DIJKSTRA_UNREACHED;
+        ws->dist[ws->_touched[i]] = UINT64_MAX;
+    }
+    ws->_touchedCnt = 0;
+}
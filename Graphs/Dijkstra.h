@@ -0,0 +1,51 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Dijkstra
+ * library, which computes single-source shortest paths on CSR Graphs with
+ * Dijkstra's algorithm, using a Fibonacci Heap as the priority queue of
+ * tentative distances (with key decreases, so each vertex enters the heap at
+ * most once).
+ * Searches run in a workspace, which holds the heap, one heap node for each
+ * vertex and the distances array. A workspace can be reused for many searches
+ * on graphs with the same number of vertices: it is reset in time
+ * proportional to the number of vertices reached by the last search, instead
+ * of the size of the graph. A search can also stop as soon as a given set of
+ * target vertices has been settled.
+ * Distances of unreachable vertices are set to UINT64_MAX.
+ * NOTE: A workspace must be used by one thread at a time, while the graph is
+ * only read, so many workspaces can search the same graph concurrently.
+ * NOTE: This library requires the Fibonacci Heap library.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "CSRGraph.h"
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Dijkstra search workspace. Distances can be read after a search. */
+typedef struct {
+    FibHeap *_heap;             // Tentative distances.
+    FibTreeNode *_nodes;        // Heap nodes, one for each vertex.
+    unsigned char *_state;      // Unreached, queued or settled.
+    uint32_t *_touched;         // Vertices reached by the last search.
+    ulong _touchedCnt;
+    uint64_t *dist;             // Distances from the last source.
+    ulong verticesCount;
+} DijkstraWorkspace;
+
+/* Library functions. */
+DijkstraWorkspace *createDijkstraWorkspace(ulong verticesCount);
+void eraseDijkstraWorkspace(DijkstraWorkspace *ws);
+int dijkstraSearch(DijkstraWorkspace *ws, CSRGraph *graph, ulong source,
+                   const uint32_t *targets, ulong targetsCnt);
+int dijkstra(CSRGraph *graph, ulong source, uint64_t *dist);
+
+#endif
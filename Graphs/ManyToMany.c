@@ -0,0 +1,94 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Many To Many library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "ManyToMany.h"
+
+/* Shared job description. Sources are taken in order by the threads. */
+typedef struct {
+    CSRGraph *graph;
+    const uint32_t *sources;
+    ulong sourcesCnt;
+    const uint32_t *targets;
+    ulong targetsCnt;
+    uint64_t *table;
+    ulong nextSource;         // Next source to be taken.
+    ulong workersCnt;         // Workers that got a workspace.
+    int failed;
+} M2MJob;
+
+/* Declarations of internal library subroutines. */
+void *_m2mWorker(void *arg);
+
+// LIBRARY FUNCTIONS //
+/* Computes the distances from each source to each target, storing them in a
+ * table of sourcesCnt * targetsCnt entries.
+ * Returns 0 on success, -1 on failure.
+ */
+int manyToMany(CSRGraph *graph, const uint32_t *sources, ulong sourcesCnt,
+               const uint32_t *targets, ulong targetsCnt, ulong threads,
+               uint64_t *table) {
+    if ((graph == NULL) || (sources == NULL) || (targets == NULL) ||
+        (table == NULL)) return -1;
+    if ((sourcesCnt == 0) || (targetsCnt == 0)) return 0;
+
+    M2MJob job;
+    job.graph = graph;
+    job.sources = sources;
+    job.sourcesCnt = sourcesCnt;
+    job.targets = targets;
+    job.targetsCnt = targetsCnt;
+    job.table = table;
+    job.nextSource = 0;
+    job.workersCnt = 0;
+    job.failed = 0;
+
+    // Start the workers, the calling thread included.
+    ulong threadsCnt = threads > 1 ? threads : 1;
+    if (threadsCnt > sourcesCnt) threadsCnt = sourcesCnt;
+    pthread_t *workers = calloc(threadsCnt, sizeof(pthread_t));
+    ulong started = 0;
+    if (workers != NULL) {
+        for (ulong i = 1; i < threadsCnt; i++) {
+            if (pthread_create(&(workers[i]), NULL, _m2mWorker, &job)) break;
+            started++;
+        }
+    }
+    _m2mWorker(&job);
+    for (ulong i = 1; i <= started; i++) pthread_join(workers[i], NULL);
+    free(workers);
+    // Each worker takes sources until none is left, so one is enough.
+    return (job.failed || (job.workersCnt == 0)) ? -1 : 0;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Worker thread routine: takes sources until none is left. */
+void *_m2mWorker(void *arg) {
+    M2MJob *job = (M2MJob *)arg;
+    DijkstraWorkspace *ws = createDijkstraWorkspace(job->graph->verticesCount);
+    // Others may still do the job: it's over only if nobody can.
+    if (ws == NULL) return NULL;
+    __atomic_fetch_add(&(job->workersCnt), 1, __ATOMIC_RELAXED);
+    while (1) {
+        ulong i = __atomic_fetch_add(&(job->nextSource), 1, __ATOMIC_RELAXED);
+        if (i >= job->sourcesCnt) break;
+        uint64_t *row = job->table + (i * job->targetsCnt);
+        if (dijkstraSearch(ws, job->graph, job->sources[i], job->targets,
+                           job->targetsCnt) != 0)
+            __atomic_store_n(&(job->failed), 1, __ATOMIC_RELAXED);
+        for (ulong j = 0; j < job->targetsCnt; j++)
+            row[j] = ws->dist[job->targets[j]];
+    }
+    eraseDijkstraWorkspace(ws);
+    return NULL;
+}
@@ -0,0 +1,33 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains declarations for the Many To Many library, which
+ * computes distance tables between a set of source vertices and a set of
+ * target vertices of a CSR Graph.
+ * Sources are distributed dynamically among threads. Each thread runs
+ * Dijkstra searches in its own workspace, which is reused for all of its
+ * sources (see the Dijkstra library), and writes a row of the table for each
+ * source. The graph is shared and only read.
+ * The table is a dense, row-major sourcesCnt x targetsCnt matrix; unreachable
+ * targets are at distance UINT64_MAX.
+ * NOTE: This library requires the Fibonacci Heap library and POSIX threads.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef MANYTOMANY_H
+#define MANYTOMANY_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "CSRGraph.h"
+#include "Dijkstra.h"
+
+/* Library functions. */
+int manyToMany(CSRGraph *graph, const uint32_t *sources, ulong sourcesCnt,
+               const uint32_t *targets, ulong targetsCnt, ulong threads,
+               uint64_t *table);
+
+#endif
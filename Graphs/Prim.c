@@ -0,0 +1,83 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Prim library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+
+#include "Prim.h"
+
+/* Vertex states. */
+#define PRIM_UNREACHED 0
+#define PRIM_QUEUED 1
+#define PRIM_IN_TREE 2
+
+// LIBRARY FUNCTIONS //
+/* Computes a minimum spanning tree of the component of a root vertex,
+ * storing the parent of each vertex in an array of verticesCount entries.
+ * The total weight of the tree is stored too, if requested.
+ * Returns 0 on success, -1 on failure.
+ */
+int prim(CSRGraph *graph, ulong root, uint32_t *parent,
+         uint64_t *totalWeight) {
+    if ((graph == NULL) || (parent == NULL)) return -1;
+    if (root >= graph->verticesCount) return -1;
+    ulong verticesCount = graph->verticesCount;
+
+    // Each vertex has its own node, which lives in this array.
+    FibTreeNode *nodes = calloc(verticesCount, sizeof(FibTreeNode));
+    unsigned char *state = calloc(verticesCount, sizeof(unsigned char));
+    ulong treeOrd = 1;
+    while ((1UL << treeOrd) < verticesCount) treeOrd++;
+    FibHeap *heap = createFibHeap(treeOrd + 1);
+    if ((nodes == NULL) || (state == NULL) || (heap == NULL)) {
+        free(nodes);
+        free(state);
+        eraseFibHeap(heap, 0);
+        return -1;
+    }
+    for (ulong v = 0; v < verticesCount; v++) {
+        nodes[v].elem = (void *)v;
+        parent[v] = UINT32_MAX;
+    }
+
+    int ret = 0;
+    uint64_t weight = 0;
+    state[root] = PRIM_QUEUED;
+    if (fhInsertNode(heap, &(nodes[root]), 0) == NULL) ret = -1;
+    while (heap->min != NULL) {
+        // The minimum joins the tree with its lightest edge.
+        FibTreeNode *minNode = fhDeleteMin(heap);
+        ulong u = (ulong)minNode->elem;
+        state[u] = PRIM_IN_TREE;
+        weight += minNode->key;
+        for (uint64_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            ulong v = graph->targets[e];
+            uint64_t w = graph->weights[e];
+            if (state[v] == PRIM_IN_TREE) continue;
+            if (state[v] == PRIM_QUEUED) {
+                if (w >= nodes[v].key) continue;
+                fhDecreaseKey(heap, &(nodes[v]), nodes[v].key - w);
+            } else {
+                if (fhInsertNode(heap, &(nodes[v]), w) == NULL) {
+                    ret = -1;
+                    continue;
+                }
+                state[v] = PRIM_QUEUED;
+            }
+            parent[v] = (uint32_t)u;
+        }
+    }
+    if (totalWeight != NULL) *totalWeight = weight;
+
+    eraseFibHeap(heap, DELETE_KEEP_NODES);
+    free(nodes);
+    free(state);
+    return ret;
+}
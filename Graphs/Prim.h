@@ -0,0 +1,33 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains declarations for the Prim library, which computes
+ * minimum spanning trees of undirected CSR Graphs with Prim's algorithm,
+ * using a Fibonacci Heap as the priority queue of vertices, keyed by the
+ * weight of their lightest edge towards the tree (with key decreases, so each
+ * vertex enters the heap at most once).
+ * The tree spans the connected component of a given root vertex, and is
+ * returned as an array of parents: the parent of the root, and of vertices
+ * outside its component, is UINT32_MAX.
+ * NOTE: Undirected graphs must be stored with both directions of each edge
+ * (see the CSR Graph library).
+ * NOTE: This library requires the Fibonacci Heap library.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef PRIM_H
+#define PRIM_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "CSRGraph.h"
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Library functions. */
+int prim(CSRGraph *graph, ulong root, uint32_t *parent,
+         uint64_t *totalWeight);
+
+#endif
@@ -0,0 +1,153 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Offline converter of text graph files to the binary CSR Graph format, which
+ * can then be loaded instantly with "csrLoad". Supported input formats are:
+ * - DIMACS shortest paths graphs (".gr"): a "p sp <n> <m>" line followed by
+ *   "a <u> <v> <w>" arc lines, with vertices numbered from 1;
+ * - edge lists: "<u> <v> [w]" lines, with vertices numbered from 0 and
+ *   weights defaulting to 1.
+ * The format is detected from the first line that is not a comment ("c" or
+ * "#" lines, and empty ones).
+ * Usage: csrconvert [-u] <input file> <output file>
+ * where -u adds the reverse of each edge (for undirected edge lists).
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CSRGraph.h"
+
+/* Edge list being read. */
+typedef struct {
+    uint32_t *sources;
+    uint32_t *targets;
+    uint32_t *weights;
+    ulong size;
+    ulong cap;
+} EdgeList;
+
+/* Appends an edge to the list, exiting on failure. */
+void addEdge(EdgeList *edges, uint64_t u, uint64_t v, uint64_t w) {
+    if ((u > UINT32_MAX) || (v > UINT32_MAX) || (w > UINT32_MAX)) {
+        fprintf(stderr, "Edge (%lu, %lu, %lu) out of range.\n", u, v, w);
+        exit(EXIT_FAILURE);
+    }
+    if (edges->size == edges->cap) {
+        ulong newCap = edges->cap > 0 ? edges->cap * 2 : 1024;
+        edges->sources = reallocarray(edges->sources, newCap,
+                                      sizeof(uint32_t));
+        edges->targets = reallocarray(edges->targets, newCap,
+                                      sizeof(uint32_t));
+        edges->weights = reallocarray(edges->weights, newCap,
+                                      sizeof(uint32_t));
+        if ((edges->sources == NULL) || (edges->targets == NULL) ||
+            (edges->weights == NULL)) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+        edges->cap = newCap;
+    }
+    edges->sources[edges->size] = (uint32_t)u;
+    edges->targets[edges->size] = (uint32_t)v;
+    edges->weights[edges->size] = (uint32_t)w;
+    edges->size++;
+}
+
+/* Parses up to max unsigned integers from a string, returning how many. */
+int parseNumbers(const char *str, uint64_t *nums, int max) {
+    int cnt = 0;
+    while (cnt < max) {
+        char *end;
+        while ((*str == ' ') || (*str == '\t')) str++;
+        if ((*str < '0') || (*str > '9')) break;
+        nums[cnt++] = strtoull(str, &end, 10);
+        str = end;
+    }
+    return cnt;
+}
+
+int main(int argc, char **argv) {
+    int undirected = (argc == 4) && !strcmp(argv[1], "-u");
+    if ((argc != 3) && !undirected) {
+        fprintf(stderr, "Usage: %s [-u] <input file> <output file>\n",
+                argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    const char *inPath = argv[argc - 2], *outPath = argv[argc - 1];
+    FILE *in = fopen(inPath, "r");
+    if (in == NULL) {
+        perror(inPath);
+        exit(EXIT_FAILURE);
+    }
+
+    EdgeList edges = {0};
+    uint64_t verticesCount = 0;
+    int dimacs = -1;  // Unknown yet.
+    char *line = NULL;
+    size_t lineCap = 0;
+    ulong lineNum = 0;
+    while (getline(&line, &lineCap, in) != -1) {
+        lineNum++;
+        char *str = line;
+        while ((*str == ' ') || (*str == '\t')) str++;
+        if ((*str == '\n') || (*str == '\0') || (*str == '#') ||
+            (*str == 'c')) continue;
+        if (dimacs == -1) dimacs = (*str == 'p') || (*str == 'a');
+        uint64_t nums[3];
+        if (dimacs && (*str == 'p')) {
+            if ((sscanf(str, "p sp %lu %*u", &verticesCount) != 1) ||
+                (verticesCount == 0)) {
+                fprintf(stderr, "%s:%lu: bad problem line.\n", inPath,
+                        lineNum);
+                exit(EXIT_FAILURE);
+            }
+        } else if (dimacs && (*str == 'a')) {
+            if ((parseNumbers(str + 1, nums, 3) != 3) || (nums[0] == 0) ||
+                (nums[1] == 0)) {
+                fprintf(stderr, "%s:%lu: bad arc line.\n", inPath, lineNum);
+                exit(EXIT_FAILURE);
+            }
+            addEdge(&edges, nums[0] - 1, nums[1] - 1, nums[2]);
+        } else if (!dimacs) {
+            int cnt = parseNumbers(str, nums, 3);
+            if (cnt < 2) {
+                fprintf(stderr, "%s:%lu: bad edge line.\n", inPath, lineNum);
+                exit(EXIT_FAILURE);
+            }
+            addEdge(&edges, nums[0], nums[1], cnt == 3 ? nums[2] : 1);
+            if (nums[0] + 1 > verticesCount) verticesCount = nums[0] + 1;
+            if (nums[1] + 1 > verticesCount) verticesCount = nums[1] + 1;
+        }
+    }
+    free(line);
+    fclose(in);
+
+    if (undirected) {
+        ulong directedCnt = edges.size;
+        for (ulong i = 0; i < directedCnt; i++)
+            addEdge(&edges, edges.targets[i], edges.sources[i],
+                    edges.weights[i]);
+    }
+    CSRGraph *graph = createCSRGraph(verticesCount, edges.size, edges.sources,
+                                     edges.targets, edges.weights);
+    free(edges.sources);
+    free(edges.targets);
+    free(edges.weights);
+    if (graph == NULL) {
+        fprintf(stderr, "Invalid graph, or out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (csrSave(graph, outPath) != 0) {
+        perror(outPath);
+        exit(EXIT_FAILURE);
+    }
+    printf("%lu vertices, %lu edges written to %s.\n", graph->verticesCount,
+           graph->edgesCount, outPath);
+    eraseCSRGraph(graph);
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,174 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Multi-Index Heap library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+
+#include "MultiIndexHeap.h"
+
+/* Declarations of internal library subroutines. */
+void _unlinkEntry(MultiIndexHeap *mih, MIEntry *entry);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new Multi-Index Heap with a given number of
+ * indexes. The initial maximum tree order is that of each heap (see
+ * "createFibHeap").
+ */
+MultiIndexHeap *createMultiIndexHeap(ulong indexesCnt, ulong initMaxTreeOrd) {
+    if ((indexesCnt == 0) || (initMaxTreeOrd == 0)) return NULL;
+    MultiIndexHeap *newMih = calloc(1, sizeof(MultiIndexHeap));
+    if (newMih == NULL) return NULL;
+    newMih->_heaps = calloc(indexesCnt, sizeof(FibHeap *));
+    if (newMih->_heaps == NULL) {
+        free(newMih);
+        return NULL;
+    }
+    newMih->indexesCount = indexesCnt;
+    for (ulong i = 0; i < indexesCnt; i++) {
+        (newMih->_heaps)[i] = createFibHeap(initMaxTreeOrd);
+        if ((newMih->_heaps)[i] == NULL) {
+            eraseMultiIndexHeap(newMih, 0);
+            return NULL;
+        }
+    }
+    newMih->_entries = NULL;
+    newMih->entriesCount = 0;
+    return newMih;
+}
+
+/* Destroys a Multi-Index Heap, freeing memory. */
+void eraseMultiIndexHeap(MultiIndexHeap *mih, int opts) {
+    if (mih == NULL) return;
+    // Nodes belong to the entries, which are freed here.
+    for (ulong i = 0; i < mih->indexesCount; i++)
+        eraseFibHeap((mih->_heaps)[i], DELETE_KEEP_NODES);
+    MIEntry *curr = mih->_entries;
+    while (curr != NULL) {
+        MIEntry *nextOne = curr->_next;
+        eraseMIEntry(curr, opts);
+        curr = nextOne;
+    }
+    free(mih->_heaps);
+    free(mih);
+}
+
+/* Deletes a given entry, freeing memory. */
+void eraseMIEntry(MIEntry *entry, int opts) {
+    if (entry == NULL) return;
+    if (opts & DELETE_FREE_DATA) free(entry->elem);
+    free(entry);
+}
+
+/* Tells whether a given container is empty or not. */
+int isMultiIndexHeapEmpty(MultiIndexHeap *mih) {
+    if (mih == NULL) return -1;
+    return mih->entriesCount == 0;
+}
+
+/* Creates a new entry, with a key for each index, and adds it to all
+ * indexes. Returns a pointer to the entry, or NULL on failure.
+ */
+MIEntry *mihInsert(MultiIndexHeap *mih, void *elem, const uint64_t *keys) {
+    if ((mih == NULL) || (keys == NULL)) return NULL;
+    MIEntry *newEntry = calloc(1, sizeof(MIEntry) +
+                                  (mih->indexesCount * sizeof(FibTreeNode)));
+    if (newEntry == NULL) return NULL;
+    newEntry->elem = elem;
+    for (ulong i = 0; i < mih->indexesCount; i++) {
+        (newEntry->_nodes)[i].elem = newEntry;
+        if (fhInsertNode((mih->_heaps)[i], &((newEntry->_nodes)[i]),
+                         keys[i]) == NULL) {
+            // Take the entry back from the indexes it entered.
+            for (ulong j = 0; j < i; j++)
+                fhDelete((mih->_heaps)[j], &((newEntry->_nodes)[j]));
+            free(newEntry);
+            return NULL;
+        }
+    }
+    newEntry->_prev = NULL;
+    newEntry->_next = mih->_entries;
+    if (mih->_entries != NULL) mih->_entries->_prev = newEntry;
+    mih->_entries = newEntry;
+    mih->entriesCount++;
+    return newEntry;
+}
+
+/* Returns the key of an entry in a given index. */
+uint64_t mihKey(MIEntry *entry, ulong index) {
+    if (entry == NULL) return 0;
+    return (entry->_nodes)[index].key;
+}
+
+/* Returns the entry with the minimum key in a given index. */
+MIEntry *mihFindMin(MultiIndexHeap *mih, ulong index) {
+    if ((mih == NULL) || (index >= mih->indexesCount)) return NULL;
+    FibTreeNode *min = (mih->_heaps)[index]->min;
+    if (min == NULL) return NULL;
+    return min->elem;
+}
+
+/* Deletes the entry with the minimum key in a given index from all indexes,
+ * and returns it.
+ */
+MIEntry *mihDeleteMin(MultiIndexHeap *mih, ulong index) {
+    if ((mih == NULL) || (index >= mih->indexesCount)) return NULL;
+    FibTreeNode *min = fhDeleteMin((mih->_heaps)[index]);
+    if (min == NULL) return NULL;
+    MIEntry *entry = min->elem;
+    for (ulong i = 0; i < mih->indexesCount; i++)
+        if (i != index) fhDelete((mih->_heaps)[i], &((entry->_nodes)[i]));
+    _unlinkEntry(mih, entry);
+    return entry;
+}
+
+/* Deletes an entry from all indexes and returns it. */
+MIEntry *mihDelete(MultiIndexHeap *mih, MIEntry *entry) {
+    if ((mih == NULL) || (entry == NULL)) return NULL;
+    for (ulong i = 0; i < mih->indexesCount; i++)
+        fhDelete((mih->_heaps)[i], &((entry->_nodes)[i]));
+    _unlinkEntry(mih, entry);
+    return entry;
+}
+
+/* Decreases entry's key in a given index of dec (key -= dec).
+ * Returns a pointer to the entry.
+ */
+MIEntry *mihDecreaseKey(MultiIndexHeap *mih, MIEntry *entry, ulong index,
+                        uint64_t dec) {
+    if ((mih == NULL) || (entry == NULL) || (index >= mih->indexesCount))
+        return NULL;
+    if (fhDecreaseKey((mih->_heaps)[index], &((entry->_nodes)[index]),
+                      dec) == NULL) return NULL;
+    return entry;
+}
+
+/* Increases entry's key in a given index of inc (key += inc).
+ * Returns a pointer to the entry, or NULL on failure (in which case the entry
+ * is left as it was, in all indexes).
+ */
+MIEntry *mihIncreaseKey(MultiIndexHeap *mih, MIEntry *entry, ulong index,
+                        uint64_t inc) {
+    if ((mih == NULL) || (entry == NULL) || (index >= mih->indexesCount))
+        return NULL;
+    if (fhIncreaseKey((mih->_heaps)[index], &((entry->_nodes)[index]),
+                      inc) == NULL) return NULL;
+    return entry;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Removes an entry from the list of entries of a container. */
+void _unlinkEntry(MultiIndexHeap *mih, MIEntry *entry) {
+    if (entry->_prev != NULL) entry->_prev->_next = entry->_next;
+    else mih->_entries = entry->_next;
+    if (entry->_next != NULL) entry->_next->_prev = entry->_prev;
+    entry->_next = NULL;
+    entry->_prev = NULL;
+    mih->entriesCount--;
+}
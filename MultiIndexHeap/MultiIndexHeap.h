@@ -0,0 +1,65 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Multi-Index
+ * Heap library, a priority container that orders each element by several
+ * keys at once (e.g. connections by idle timeout and by retry backoff). It is
+ * built on top of the Fibonacci Heap library, with a heap for each index.
+ * Each element lives in a single entry, allocated at once, which embeds a
+ * heap node (i.e. links and key) for each index: nodes are inserted with
+ * "fhInsertNode", and kept by the heaps when they are deleted.
+ * The minimum of each index can be found and deleted independently, and an
+ * entry deleted through any index leaves all of them.
+ * NOTE: Entries's elements could be pointers to the heap as well. A binary
+ * flag is provided to free them when total container deletion is called.
+ * NOTE: Entries returned by deletions belong to the caller, and must be
+ * erased with "eraseMIEntry".
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef MULTIINDEXHEAP_H
+#define MULTIINDEXHEAP_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Multi-Index Heap Entry. Stores an element and a heap node for each index,
+ * whose element is the entry itself.
+ */
+typedef struct __miEntry {
+    void *elem;                      // Element stored in the entry.
+    struct __miEntry *_next;         // Next entry in the container.
+    struct __miEntry *_prev;         // Previous entry in the container.
+    FibTreeNode _nodes[];            // Nodes, one for each index.
+} MIEntry;
+
+/* Multi-Index Heap. Keeps a heap for each index, and a list of all entries
+ * to free them at once.
+ */
+typedef struct {
+    FibHeap **_heaps;
+    ulong indexesCount;
+    MIEntry *_entries;
+    ulong entriesCount;
+} MultiIndexHeap;
+
+/* Library functions. */
+MultiIndexHeap *createMultiIndexHeap(ulong indexesCnt, ulong initMaxTreeOrd);
+void eraseMultiIndexHeap(MultiIndexHeap *mih, int opts);
+void eraseMIEntry(MIEntry *entry, int opts);
+int isMultiIndexHeapEmpty(MultiIndexHeap *mih);
+MIEntry *mihInsert(MultiIndexHeap *mih, void *elem, const uint64_t *keys);
+uint64_t mihKey(MIEntry *entry, ulong index);
+MIEntry *mihFindMin(MultiIndexHeap *mih, ulong index);
+MIEntry *mihDeleteMin(MultiIndexHeap *mih, ulong index);
+MIEntry *mihDelete(MultiIndexHeap *mih, MIEntry *entry);
+MIEntry *mihDecreaseKey(MultiIndexHeap *mih, MIEntry *entry, ulong index,
+                        uint64_t dec);
+MIEntry *mihIncreaseKey(MultiIndexHeap *mih, MIEntry *entry, ulong index,
+                        uint64_t inc);
+
+#endif
@@ -0,0 +1,412 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Sequence Heap library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SequenceHeap_uint64-keys.h"
+
+/* Declarations of internal library subroutines. */
+int _entryCmp(const void *entry, const void *otherEntry);
+void _insSiftUp(SeqHeap *heap, ulong pos);
+void _insSiftDown(SeqHeap *heap, ulong pos);
+int _flush(SeqHeap *heap);
+int _addRun(SeqHeap *heap, ulong group, SeqRun *run);
+int _mergeGroup(SeqHeap *heap, ulong group, SeqRun *out);
+int _refill(SeqHeap *heap);
+int _ltBuild(SeqLoserTree *lt, SeqRun **runs, ulong runsCnt);
+int _ltLess(SeqLoserTree *lt, ulong run, ulong otherRun);
+int _ltPop(SeqLoserTree *lt, SeqEntry *out);
+void _ltErase(SeqLoserTree *lt);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new Sequence Heap, given the size of its buffers
+ * and the maximum number of runs in a group (0 for the defaults).
+ */
+SeqHeap *createSeqHeap(ulong bufferSize, ulong arity) {
+    if (bufferSize == 0) bufferSize = SQ_DEFAULT_BUFFER;
+    if (arity == 0) arity = SQ_DEFAULT_ARITY;
+    if (arity < 2) return NULL;
+    SeqHeap *newHeap = calloc(1, sizeof(SeqHeap));
+    if (newHeap == NULL) return NULL;
+    newHeap->_insBuf = calloc(bufferSize, sizeof(SeqEntry));
+    newHeap->_delBuf = calloc(bufferSize, sizeof(SeqEntry));
+    newHeap->_tmp = calloc(2 * bufferSize, sizeof(SeqEntry));
+    if ((newHeap->_insBuf == NULL) || (newHeap->_delBuf == NULL) ||
+        (newHeap->_tmp == NULL)) {
+        free(newHeap->_insBuf);
+        free(newHeap->_delBuf);
+        free(newHeap->_tmp);
+        free(newHeap);
+        return NULL;
+    }
+    newHeap->_insCnt = 0;
+    newHeap->_delPos = 0;
+    newHeap->_delCnt = 0;
+    newHeap->_bufSize = bufferSize;
+    newHeap->_arity = arity;
+    newHeap->_groups = NULL;
+    newHeap->_groupsCnt = 0;
+    newHeap->_merger._runs = NULL;
+    newHeap->_merger._runsCnt = 0;
+    newHeap->_merger._leaves = 0;
+    newHeap->_merger._tree = NULL;
+    newHeap->_merger._heads = NULL;
+    newHeap->_mergerDirty = 1;
+    newHeap->itemsCount = 0;
+    return newHeap;
+}
+
+/* Destroys a Sequence Heap, freeing memory. */
+void eraseSeqHeap(SeqHeap *heap, int opts) {
+    if (heap == NULL) return;
+    if (opts & DELETE_FREE_DATA) {
+        for (ulong i = 0; i < heap->_insCnt; i++)
+            free((heap->_insBuf)[i].elem);
+        for (ulong i = heap->_delPos; i < heap->_delCnt; i++)
+            free((heap->_delBuf)[i].elem);
+    }
+    for (ulong g = 0; g < heap->_groupsCnt; g++) {
+        SeqGroup *group = &((heap->_groups)[g]);
+        for (ulong i = 0; i < group->_runsCnt; i++) {
+            SeqRun *run = &((group->_runs)[i]);
+            if (opts & DELETE_FREE_DATA)
+                for (ulong j = run->_pos; j < run->_len; j++)
+                    free((run->_data)[j].elem);
+            free(run->_data);
+        }
+        free(group->_runs);
+    }
+    free(heap->_groups);
+    _ltErase(&(heap->_merger));
+    free(heap->_insBuf);
+    free(heap->_delBuf);
+    free(heap->_tmp);
+    free(heap);
+}
+
+/* Tells whether a given heap is empty or not. */
+int isSeqHeapEmpty(SeqHeap *heap) {
+    if (heap == NULL) return -1;
+    return heap->itemsCount == 0;
+}
+
+/* Adds an element to the heap. Returns 0 on success, -1 on failure. */
+int sqInsert(SeqHeap *heap, void *elem, uint64_t key) {
+    if (heap == NULL) return -1;
+    if ((heap->_insCnt == heap->_bufSize) && (_flush(heap) != 0)) return -1;
+    (heap->_insBuf)[heap->_insCnt].key = key;
+    (heap->_insBuf)[heap->_insCnt].elem = elem;
+    _insSiftUp(heap, (heap->_insCnt)++);
+    heap->itemsCount++;
+    return 0;
+}
+
+/* Gets the element with the minimum key, and the key, without deleting it.
+ * Either pointer may be NULL. Returns 0 on success, -1 if the heap is empty.
+ */
+int sqFindMin(SeqHeap *heap, void **elem, uint64_t *key) {
+    if ((heap == NULL) || (heap->itemsCount == 0)) return -1;
+    if ((heap->_delPos == heap->_delCnt) && (_refill(heap) != 0)) return -1;
+    SeqEntry *minEntry;
+    if ((heap->_insCnt > 0) && ((heap->_delPos == heap->_delCnt) ||
+        ((heap->_insBuf)[0].key < (heap->_delBuf)[heap->_delPos].key)))
+        minEntry = &((heap->_insBuf)[0]);
+    else minEntry = &((heap->_delBuf)[heap->_delPos]);
+    if (elem != NULL) *elem = minEntry->elem;
+    if (key != NULL) *key = minEntry->key;
+    return 0;
+}
+
+/* Deletes the element with the minimum key, returning it and its key.
+ * Either pointer may be NULL. Returns 0 on success, -1 if the heap is empty.
+ */
+int sqDeleteMin(SeqHeap *heap, void **elem, uint64_t *key) {
+    if ((heap == NULL) || (heap->itemsCount == 0)) return -1;
+    if ((heap->_delPos == heap->_delCnt) && (_refill(heap) != 0)) return -1;
+    SeqEntry minEntry;
+    if ((heap->_insCnt > 0) && ((heap->_delPos == heap->_delCnt) ||
+        ((heap->_insBuf)[0].key < (heap->_delBuf)[heap->_delPos].key))) {
+        minEntry = (heap->_insBuf)[0];
+        (heap->_insBuf)[0] = (heap->_insBuf)[--(heap->_insCnt)];
+        _insSiftDown(heap, 0);
+    } else minEntry = (heap->_delBuf)[(heap->_delPos)++];
+    if (elem != NULL) *elem = minEntry.elem;
+    if (key != NULL) *key = minEntry.key;
+    heap->itemsCount--;
+    return 0;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Compares two entries by key, for qsort. */
+int _entryCmp(const void *entry, const void *otherEntry) {
+    uint64_t key = ((const SeqEntry *)entry)->key;
+    uint64_t otherKey = ((const SeqEntry *)otherEntry)->key;
+    return (key > otherKey) - (key < otherKey);
+}
+
+/* Moves an entry of the insertion buffer up to its place. */
+void _insSiftUp(SeqHeap *heap, ulong pos) {
+    SeqEntry *buf = heap->_insBuf;
+    SeqEntry entry = buf[pos];
+    while (pos > 0) {
+        ulong father = (pos - 1) / 2;
+        if (buf[father].key <= entry.key) break;
+        buf[pos] = buf[father];
+        pos = father;
+    }
+    buf[pos] = entry;
+}
+
+/* Moves an entry of the insertion buffer down to its place. */
+void _insSiftDown(SeqHeap *heap, ulong pos) {
+    SeqEntry *buf = heap->_insBuf;
+    ulong cnt = heap->_insCnt;
+    if (pos >= cnt) return;
+    SeqEntry entry = buf[pos];
+    while ((2 * pos) + 1 < cnt) {
+        ulong son = (2 * pos) + 1;
+        if ((son + 1 < cnt) && (buf[son + 1].key < buf[son].key)) son++;
+        if (entry.key <= buf[son].key) break;
+        buf[pos] = buf[son];
+        pos = son;
+    }
+    buf[pos] = entry;
+}
+
+/* Turns the insertion buffer into a new run. Its elements are merged with
+ * those in the deletion buffer first, so that the latter keeps the smallest
+ * ones and is never greater than anything in the runs.
+ * Returns 0 on success, -1 on failure (in which case nothing changes).
+ */
+int _flush(SeqHeap *heap) {
+    SeqEntry *ins = heap->_insBuf, *del = heap->_delBuf + heap->_delPos;
+    ulong insCnt = heap->_insCnt, delCnt = heap->_delCnt - heap->_delPos;
+    qsort(ins, insCnt, sizeof(SeqEntry), _entryCmp);
+    ulong i = 0, j = 0, k = 0;
+    while ((i < insCnt) && (j < delCnt))
+        (heap->_tmp)[k++] = ins[i].key < del[j].key ? ins[i++] : del[j++];
+    while (i < insCnt) (heap->_tmp)[k++] = ins[i++];
+    while (j < delCnt) (heap->_tmp)[k++] = del[j++];
+
+    SeqRun newRun;
+    newRun._data = malloc(insCnt * sizeof(SeqEntry));
+    if (newRun._data == NULL) return -1;
+    memcpy(newRun._data, heap->_tmp + delCnt, insCnt * sizeof(SeqEntry));
+    newRun._pos = 0;
+    newRun._len = insCnt;
+    if (_addRun(heap, 0, &newRun) != 0) {
+        free(newRun._data);
+        return -1;
+    }
+    memcpy(heap->_delBuf, heap->_tmp, delCnt * sizeof(SeqEntry));
+    heap->_delPos = 0;
+    heap->_delCnt = delCnt;
+    heap->_insCnt = 0;
+    heap->_mergerDirty = 1;
+    return 0;
+}
+
+/* Adds a run to a group. If the group is full, its runs are merged into a
+ * single one, which goes to the next group.
+ * Returns 0 on success, -1 on failure.
+ */
+int _addRun(SeqHeap *heap, ulong group, SeqRun *run) {
+    if (group == heap->_groupsCnt) {
+        SeqGroup *newGroups = reallocarray(heap->_groups, heap->_groupsCnt + 1,
+                                           sizeof(SeqGroup));
+        if (newGroups == NULL) return -1;
+        heap->_groups = newGroups;
+        newGroups[group]._runs = calloc(heap->_arity, sizeof(SeqRun));
+        if (newGroups[group]._runs == NULL) return -1;
+        newGroups[group]._runsCnt = 0;
+        heap->_groupsCnt++;
+    }
+    SeqGroup *currGroup = &((heap->_groups)[group]);
+    if (currGroup->_runsCnt == heap->_arity) {
+        SeqRun mergedRun;
+        if (_mergeGroup(heap, group, &mergedRun) != 0) return -1;
+        if (_addRun(heap, group + 1, &mergedRun) != 0) {
+            // The merged run can't go anywhere: keep it in place of the
+            // runs it came from.
+            currGroup = &((heap->_groups)[group]);
+            (currGroup->_runs)[(currGroup->_runsCnt)++] = mergedRun;
+            return -1;
+        }
+        currGroup = &((heap->_groups)[group]);
+    }
+    (currGroup->_runs)[(currGroup->_runsCnt)++] = *run;
+    return 0;
+}
+
+/* Merges all runs of a group into a single one, emptying the group.
+ * Returns 0 on success, -1 on failure (in which case nothing changes).
+ */
+int _mergeGroup(SeqHeap *heap, ulong group, SeqRun *out) {
+    SeqGroup *currGroup = &((heap->_groups)[group]);
+    SeqRun **runs = calloc(currGroup->_runsCnt, sizeof(SeqRun *));
+    if (runs == NULL) return -1;
+    ulong total = 0;
+    for (ulong i = 0; i < currGroup->_runsCnt; i++) {
+        runs[i] = &((currGroup->_runs)[i]);
+        total += runs[i]->_len - runs[i]->_pos;
+    }
+    SeqLoserTree lt;
+    out->_data = malloc((total > 0 ? total : 1) * sizeof(SeqEntry));
+    if ((out->_data == NULL) ||
+        (_ltBuild(&lt, runs, currGroup->_runsCnt) != 0)) {
+        free(out->_data);
+        free(runs);
+        return -1;
+    }
+    out->_pos = 0;
+    out->_len = 0;
+    while (_ltPop(&lt, &((out->_data)[out->_len]))) out->_len++;
+    _ltErase(&lt);
+    for (ulong i = 0; i < currGroup->_runsCnt; i++)
+        free((currGroup->_runs)[i]._data);
+    currGroup->_runsCnt = 0;
+    heap->_mergerDirty = 1;
+    return 0;
+}
+
+/* Refills the deletion buffer with the smallest elements of all runs.
+ * If runs changed in the meantime, exhausted ones are dropped and the merger
+ * is built anew. Returns 0 on success, -1 on failure.
+ */
+int _refill(SeqHeap *heap) {
+    heap->_delPos = 0;
+    heap->_delCnt = 0;
+    if (heap->_mergerDirty) {
+        ulong runsCnt = 0;
+        for (ulong g = 0; g < heap->_groupsCnt; g++) {
+            SeqGroup *group = &((heap->_groups)[g]);
+            ulong kept = 0;
+            for (ulong i = 0; i < group->_runsCnt; i++) {
+                if ((group->_runs)[i]._pos == (group->_runs)[i]._len)
+                    free((group->_runs)[i]._data);
+                else (group->_runs)[kept++] = (group->_runs)[i];
+            }
+            group->_runsCnt = kept;
+            runsCnt += kept;
+        }
+        SeqRun **runs = calloc(runsCnt > 0 ? runsCnt : 1, sizeof(SeqRun *));
+        if (runs == NULL) return -1;
+        runsCnt = 0;
+        for (ulong g = 0; g < heap->_groupsCnt; g++)
+            for (ulong i = 0; i < (heap->_groups)[g]._runsCnt; i++)
+                runs[runsCnt++] = &(((heap->_groups)[g]._runs)[i]);
+        _ltErase(&(heap->_merger));
+        if (_ltBuild(&(heap->_merger), runs, runsCnt) != 0) {
+            free(runs);
+            return -1;
+        }
+        heap->_mergerDirty = 0;
+    }
+    while ((heap->_delCnt < heap->_bufSize) &&
+           _ltPop(&(heap->_merger), &((heap->_delBuf)[heap->_delCnt])))
+        heap->_delCnt++;
+    return 0;
+}
+
+/* Builds a loser tree over some runs, taking over the runs array.
+ * Returns 0 on success, -1 on failure (in which case the tree is empty, and
+ * the runs array still belongs to the caller).
+ */
+int _ltBuild(SeqLoserTree *lt, SeqRun **runs, ulong runsCnt) {
+    lt->_runs = runs;
+    lt->_runsCnt = runsCnt;
+    lt->_leaves = 1;
+    while (lt->_leaves < runsCnt) lt->_leaves *= 2;
+    lt->_tree = calloc(lt->_leaves, sizeof(ulong));
+    lt->_heads = calloc(lt->_leaves, sizeof(uint64_t));
+    ulong *winners = calloc(2 * lt->_leaves, sizeof(ulong));
+    if ((lt->_tree == NULL) || (lt->_heads == NULL) || (winners == NULL)) {
+        free(lt->_tree);
+        free(lt->_heads);
+        free(winners);
+        lt->_runs = NULL;
+        lt->_runsCnt = 0;
+        lt->_tree = NULL;
+        lt->_heads = NULL;
+        return -1;
+    }
+    for (ulong i = 0; i < lt->_leaves; i++) {
+        if ((i < runsCnt) && (runs[i]->_pos < runs[i]->_len))
+            (lt->_heads)[i] = runs[i]->_data[runs[i]->_pos].key;
+        else (lt->_heads)[i] = UINT64_MAX;
+    }
+    // Play all matches bottom-up, storing losers in the tree.
+    for (ulong i = 0; i < lt->_leaves; i++) winners[lt->_leaves + i] = i;
+    for (ulong n = lt->_leaves - 1; n > 0; n--) {
+        ulong a = winners[2 * n], b = winners[(2 * n) + 1];
+        if (_ltLess(lt, a, b)) {
+            winners[n] = a;
+            (lt->_tree)[n] = b;
+        } else {
+            winners[n] = b;
+            (lt->_tree)[n] = a;
+        }
+    }
+    (lt->_tree)[0] = winners[1];
+    free(winners);
+    return 0;
+}
+
+/* Tells whether the current element of a run comes before that of another
+ * one. Missing and exhausted runs come after everything else.
+ */
+int _ltLess(SeqLoserTree *lt, ulong run, ulong otherRun) {
+    uint64_t key = (lt->_heads)[run], otherKey = (lt->_heads)[otherRun];
+    if (key != otherKey) return key < otherKey;
+    if (key == UINT64_MAX) {
+        // Either run could be exhausted.
+        if ((run >= lt->_runsCnt) ||
+            ((lt->_runs)[run]->_pos == (lt->_runs)[run]->_len)) return 0;
+        if ((otherRun >= lt->_runsCnt) ||
+            ((lt->_runs)[otherRun]->_pos == (lt->_runs)[otherRun]->_len))
+            return 1;
+    }
+    return run < otherRun;
+}
+
+/* Takes the smallest element out of the runs, replaying the matches of its
+ * run. Returns 1 on success, 0 if all runs are exhausted.
+ */
+int _ltPop(SeqLoserTree *lt, SeqEntry *out) {
+    ulong winner = (lt->_tree)[0];
+    if ((winner >= lt->_runsCnt) ||
+        ((lt->_runs)[winner]->_pos == (lt->_runs)[winner]->_len)) return 0;
+    SeqRun *run = (lt->_runs)[winner];
+    *out = run->_data[(run->_pos)++];
+    (lt->_heads)[winner] =
+        run->_pos < run->_len ? run->_data[run->_pos].key : UINT64_MAX;
+    for (ulong n = (lt->_leaves + winner) / 2; n > 0; n /= 2) {
+        if (_ltLess(lt, (lt->_tree)[n], winner)) {
+            ulong tmp = (lt->_tree)[n];
+            (lt->_tree)[n] = winner;
+            winner = tmp;
+        }
+    }
+    (lt->_tree)[0] = winner;
+    return 1;
+}
+
+/* Frees the memory of a loser tree, runs array included. */
+void _ltErase(SeqLoserTree *lt) {
+    free(lt->_runs);
+    free(lt->_tree);
+    free(lt->_heads);
+    lt->_runs = NULL;
+    lt->_runsCnt = 0;
+    lt->_tree = NULL;
+    lt->_heads = NULL;
+}
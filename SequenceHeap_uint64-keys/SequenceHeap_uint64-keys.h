@@ -0,0 +1,108 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Sequence Heap
+ * library, a cache-efficient priority queue by Sanders for very large queues.
+ * Keys are unsigned 64-bit integers and elements are "void *s", as in the
+ * Fibonacci Heap.
+ * Elements are stored in flat arrays instead of linked nodes:
+ * - new elements go into a small insertion buffer, a binary heap;
+ * - when it is full, the insertion buffer is sorted and becomes a new sorted
+ *   run, after its smallest elements have been swapped with those in the
+ *   deletion buffer;
+ * - runs are kept in groups of at most "arity" runs each: when a group is
+ *   full, its runs are merged into a single, longer one in the next group;
+ * - the smallest elements of all runs are merged with a loser tree into the
+ *   deletion buffer, a sorted array, whenever it gets empty.
+ * Thus, runs are only ever read and written sequentially, and the minimum is
+ * always either at the top of the insertion buffer or at the front of the
+ * deletion buffer.
+ * Functions intended to be used are marked as such, whilst other internal
+ * subroutines should not be used outside of these source files.
+ * See other comments for specific descriptions of functions and data
+ * structures.
+ * NOTE: There are no nodes to point to, so this structure offers insertions
+ * and minimum deletions only. Use the Fibonacci Heap if key modifications or
+ * deletions of specific elements are needed.
+ * NOTE: Elements could be pointers to the heap as well. A binary flag is
+ * provided to free them when total heap deletion is called.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef SEQUENCEHEAP_UINT64_KEYS_H
+#define SEQUENCEHEAP_UINT64_KEYS_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* This option can be passed to the delete functions to specify if also the
+ * elements must be freed in the heap.
+ */
+#define DELETE_FREE_DATA 0x1
+
+/* Default size of the insertion and deletion buffers. */
+#define SQ_DEFAULT_BUFFER 1024
+
+/* Default maximum number of runs in a group. */
+#define SQ_DEFAULT_ARITY 64
+
+/* Element stored in the heap, with its key. */
+typedef struct {
+    uint64_t key;
+    void *elem;
+} SeqEntry;
+
+/* Sorted run of elements. Elements before "_pos" have been consumed. */
+typedef struct {
+    SeqEntry *_data;
+    ulong _pos;
+    ulong _len;
+} SeqRun;
+
+/* Group of runs of similar length. */
+typedef struct {
+    SeqRun *_runs;
+    ulong _runsCnt;
+} SeqGroup;
+
+/* Loser tree, to merge sorted runs. Internal nodes hold the runs that lost
+ * the comparison there, while the overall winner is in the first slot.
+ * Current keys of runs are cached in a single array, so that matches don't
+ * have to go through the runs.
+ */
+typedef struct {
+    SeqRun **_runs;           // Runs being merged.
+    ulong _runsCnt;
+    ulong _leaves;            // Number of leaves, a power of 2.
+    ulong *_tree;             // Indexes of the runs in the tree.
+    uint64_t *_heads;         // Current key of each run (max if exhausted).
+} SeqLoserTree;
+
+/* Sequence Heap. */
+typedef struct {
+    SeqEntry *_insBuf;        // Insertion buffer (a binary heap).
+    ulong _insCnt;
+    SeqEntry *_delBuf;        // Deletion buffer (sorted).
+    ulong _delPos;
+    ulong _delCnt;
+    SeqEntry *_tmp;           // Merge space for the buffers.
+    ulong _bufSize;
+    ulong _arity;
+    SeqGroup *_groups;
+    ulong _groupsCnt;
+    SeqLoserTree _merger;     // Merges all runs into the deletion buffer.
+    int _mergerDirty;         // Set if runs changed since the merger was built.
+    ulong itemsCount;         // Counter for the elements in the structure.
+} SeqHeap;
+
+/* Library functions. */
+SeqHeap *createSeqHeap(ulong bufferSize, ulong arity);
+void eraseSeqHeap(SeqHeap *heap, int opts);
+int isSeqHeapEmpty(SeqHeap *heap);
+int sqInsert(SeqHeap *heap, void *elem, uint64_t key);
+int sqFindMin(SeqHeap *heap, void **elem, uint64_t *key);
+int sqDeleteMin(SeqHeap *heap, void **elem, uint64_t *key);
+
+#endif
@@ -0,0 +1,388 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Soft Heap library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "SoftHeap_uint64-keys.h"
+
+/* Declarations of internal library subroutines. */
+SoftNode *_newSoftNode(SoftHeap *heap);
+void _freeSoftNode(SoftHeap *heap, SoftNode *node);
+SoftTree *_newSoftTree(SoftHeap *heap, SoftNode *root);
+void _freeSoftTree(SoftHeap *heap, SoftTree *tree);
+SoftNode *_combine(SoftHeap *heap, SoftNode *node, SoftNode *otherNode);
+void _sift(SoftHeap *heap, SoftNode *node);
+int _linkTrees(SoftHeap *heap, SoftTree *tree);
+SoftTree *_combineTrees(SoftHeap *heap, SoftTree *tree);
+void _updateSufMin(SoftTree *tree);
+void _eraseSoftSubtree(SoftNode *root, int opts);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new Soft Heap, with an error rate in (0, 1). */
+SoftHeap *createSoftHeap(double eps) {
+    if (!((eps > 0.0) && (eps < 1.0))) return NULL;
+    SoftHeap *newHeap = calloc(1, sizeof(SoftHeap));
+    if (newHeap == NULL) return NULL;
+    newHeap->_first = NULL;
+    newHeap->_r = (ulong)ceil(log2(1.0 / eps)) + 5;
+    newHeap->eps = eps;
+    newHeap->itemsCount = 0;
+    newHeap->_chunks = NULL;
+    newHeap->_chunksCnt = 0;
+    newHeap->_used = 0;
+    newHeap->_freeNodes = NULL;
+    newHeap->_freeTrees = NULL;
+    return newHeap;
+}
+
+/* Destroys a Soft Heap, freeing memory. */
+void eraseSoftHeap(SoftHeap *heap, int opts) {
+    if (heap == NULL) return;
+    SoftTree *currTree = heap->_first;
+    while (currTree != NULL) {
+        SoftTree *nextOne = currTree->_next;
+        _eraseSoftSubtree(currTree->_root, opts);
+        free(currTree);
+        currTree = nextOne;
+    }
+    while (heap->_freeTrees != NULL) {
+        SoftTree *nextOne = heap->_freeTrees->_next;
+        free(heap->_freeTrees);
+        heap->_freeTrees = nextOne;
+    }
+    for (ulong i = 0; i < heap->_chunksCnt; i++) free((heap->_chunks)[i]);
+    free(heap->_chunks);
+    free(heap);
+}
+
+/* Deletes a given item, freeing memory. */
+void eraseSoftItem(SoftItem *item, int opts) {
+    if (item == NULL) return;
+    if (opts & DELETE_FREE_DATA) free(item->elem);
+    free(item);
+}
+
+/* Tells whether a given heap is empty or not. */
+int isSoftHeapEmpty(SoftHeap *heap) {
+    if (heap == NULL) return -1;
+    return heap->_first == NULL;
+}
+
+/* Creates a new item, as a rank 0 tree, and adds it to the heap. */
+SoftItem *shInsert(SoftHeap *heap, void *elem, uint64_t key) {
+    if (heap == NULL) return NULL;
+    SoftItem *newItem = calloc(1, sizeof(SoftItem));
+    if (newItem == NULL) return NULL;
+    newItem->key = key;
+    newItem->ckey = key;
+    newItem->elem = elem;
+    newItem->_next = NULL;
+    SoftNode *newNode = _newSoftNode(heap);
+    if (newNode == NULL) {
+        free(newItem);
+        return NULL;
+    }
+    newNode->_ckey = key;
+    newNode->_first = newItem;
+    newNode->_last = newItem;
+    newNode->_itemsCnt = 1;
+    newNode->_size = 1;
+    SoftTree *newTree = _newSoftTree(heap, newNode);
+    if (newTree == NULL) {
+        _freeSoftNode(heap, newNode);
+        free(newItem);
+        return NULL;
+    }
+    // Ranks in the list are distinct, so this works as a binary counter.
+    newTree->_next = heap->_first;
+    if (heap->_first != NULL) heap->_first->_prev = newTree;
+    heap->_first = newTree;
+    _updateSufMin(_combineTrees(heap, newTree));
+    heap->itemsCount++;
+    return newItem;
+}
+
+/* Returns an item with the minimum (corrupted) key, without deleting it. */
+SoftItem *shFindMin(SoftHeap *heap) {
+    if ((heap == NULL) || (heap->_first == NULL)) return NULL;
+    return heap->_first->_sufMin->_root->_first;
+}
+
+/* Returns the minimum (corrupted) key in the heap, or UINT64_MAX if it is
+ * empty.
+ */
+uint64_t shFindMinKey(SoftHeap *heap) {
+    if ((heap == NULL) || (heap->_first == NULL)) return UINT64_MAX;
+    return heap->_first->_sufMin->_root->_ckey;
+}
+
+/* Deletes an item with the minimum (corrupted) key and returns it, with the
+ * key it was deleted with in "ckey".
+ */
+SoftItem *shDeleteMin(SoftHeap *heap) {
+    if ((heap == NULL) || (heap->_first == NULL)) return NULL;
+    SoftTree *minTree = heap->_first->_sufMin;
+    SoftNode *root = minTree->_root;
+    SoftItem *minItem = root->_first;
+    root->_first = minItem->_next;
+    if (root->_first == NULL) root->_last = NULL;
+    root->_itemsCnt--;
+    minItem->ckey = root->_ckey;
+    minItem->_next = NULL;
+    heap->itemsCount--;
+
+    // Refill the root from its sons once it is half empty. A leaf is
+    // dropped with its last item.
+    if ((root->_itemsCnt * 2) <= root->_size) {
+        if ((root->_left != NULL) || (root->_right != NULL)) {
+            _sift(heap, root);
+            _updateSufMin(minTree);
+        } else if (root->_itemsCnt == 0) {
+            SoftTree *prev = minTree->_prev;
+            if (prev != NULL) prev->_next = minTree->_next;
+            else heap->_first = minTree->_next;
+            if (minTree->_next != NULL) minTree->_next->_prev = prev;
+            _freeSoftNode(heap, root);
+            _freeSoftTree(heap, minTree);
+            if (prev != NULL) _updateSufMin(prev);
+        }
+    }
+    return minItem;
+}
+
+/* Melds another heap into this one, which takes over its items and nodes.
+ * The other heap is destroyed in the process.
+ * Returns 0 on success, -1 on failure (in which case nothing changes).
+ */
+int shMeld(SoftHeap *heap, SoftHeap *other) {
+    if ((heap == NULL) || (other == NULL) || (heap == other)) return -1;
+    if (heap->_r != other->_r) return -1;
+
+    // Take over the nodes pool first: chunks of the other heap go before the
+    // last one of this heap, which is still being filled.
+    if (other->_chunksCnt > 0) {
+        SoftNode **newChunks = reallocarray(heap->_chunks,
+                                            heap->_chunksCnt +
+                                            other->_chunksCnt,
+                                            sizeof(SoftNode *));
+        if (newChunks == NULL) return -1;
+        heap->_chunks = newChunks;
+        SoftNode *lastChunk = NULL;
+        if (heap->_chunksCnt > 0) lastChunk = newChunks[--(heap->_chunksCnt)];
+        for (ulong i = 0; i < other->_chunksCnt; i++)
+            newChunks[(heap->_chunksCnt)++] = (other->_chunks)[i];
+        if (lastChunk != NULL) newChunks[(heap->_chunksCnt)++] = lastChunk;
+        else heap->_used = other->_used;
+    }
+    while (other->_freeNodes != NULL) {
+        SoftNode *nextOne = other->_freeNodes->_left;
+        _freeSoftNode(heap, other->_freeNodes);
+        other->_freeNodes = nextOne;
+    }
+
+    // Merge the trees lists by rank, then combine trees of equal rank.
+    SoftTree *a = heap->_first, *b = other->_first;
+    SoftTree *merged = NULL, *tail = NULL;
+    while ((a != NULL) || (b != NULL)) {
+        SoftTree *next;
+        if ((b == NULL) || ((a != NULL) && (a->_rank <= b->_rank))) {
+            next = a;
+            a = a->_next;
+        } else {
+            next = b;
+            b = b->_next;
+        }
+        next->_prev = tail;
+        next->_next = NULL;
+        if (tail != NULL) tail->_next = next;
+        else merged = next;
+        tail = next;
+    }
+    heap->_first = merged;
+    SoftTree *curr = merged;
+    while ((curr != NULL) && (curr->_next != NULL)) {
+        SoftTree *next = curr->_next;
+        if ((curr->_rank == next->_rank) &&
+            ((next->_next == NULL) || (next->_next->_rank != curr->_rank))) {
+            // Of three trees of the same rank, the last two are combined.
+            if (_linkTrees(heap, curr) != 0) curr = next;
+        } else curr = next;
+    }
+    // Combined trees may have been freed, the old tail too: look it up again.
+    tail = merged;
+    while ((tail != NULL) && (tail->_next != NULL)) tail = tail->_next;
+    if (tail != NULL) _updateSufMin(tail);
+    heap->itemsCount += other->itemsCount;
+
+    other->_first = NULL;
+    other->_chunksCnt = 0;
+    eraseSoftHeap(other, 0);
+    return 0;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Takes a new node from the pool. Returns NULL on failure. */
+SoftNode *_newSoftNode(SoftHeap *heap) {
+    SoftNode *newNode = heap->_freeNodes;
+    if (newNode != NULL) {
+        heap->_freeNodes = newNode->_left;
+    } else {
+        if ((heap->_chunksCnt == 0) ||
+            (heap->_used == (1UL << SH_POOL_CHUNK_ORD))) {
+            SoftNode **newChunks = reallocarray(heap->_chunks,
+                                                heap->_chunksCnt + 1,
+                                                sizeof(SoftNode *));
+            if (newChunks == NULL) return NULL;
+            heap->_chunks = newChunks;
+            newChunks[heap->_chunksCnt] = calloc(1UL << SH_POOL_CHUNK_ORD,
+                                                 sizeof(SoftNode));
+            if (newChunks[heap->_chunksCnt] == NULL) return NULL;
+            heap->_chunksCnt++;
+            heap->_used = 0;
+        }
+        newNode = &((heap->_chunks)[heap->_chunksCnt - 1][(heap->_used)++]);
+    }
+    newNode->_ckey = 0;
+    newNode->_first = NULL;
+    newNode->_last = NULL;
+    newNode->_itemsCnt = 0;
+    newNode->_rank = 0;
+    newNode->_size = 1;
+    newNode->_left = NULL;
+    newNode->_right = NULL;
+    return newNode;
+}
+
+/* Gives a node back to the pool. */
+void _freeSoftNode(SoftHeap *heap, SoftNode *node) {
+    node->_left = heap->_freeNodes;
+    heap->_freeNodes = node;
+}
+
+/* Creates a new tree with a given root, detached from the trees list. */
+SoftTree *_newSoftTree(SoftHeap *heap, SoftNode *root) {
+    SoftTree *newTree = heap->_freeTrees;
+    if (newTree != NULL) heap->_freeTrees = newTree->_next;
+    else {
+        newTree = calloc(1, sizeof(SoftTree));
+        if (newTree == NULL) return NULL;
+    }
+    newTree->_root = root;
+    newTree->_rank = root->_rank;
+    newTree->_prev = NULL;
+    newTree->_next = NULL;
+    newTree->_sufMin = newTree;
+    return newTree;
+}
+
+/* Keeps a tree for reuse. */
+void _freeSoftTree(SoftHeap *heap, SoftTree *tree) {
+    tree->_next = heap->_freeTrees;
+    heap->_freeTrees = tree;
+}
+
+/* Combines two nodes of the same rank under a new one, which is filled with
+ * items from below. Returns the new node, or NULL on failure.
+ */
+SoftNode *_combine(SoftHeap *heap, SoftNode *node, SoftNode *otherNode) {
+    SoftNode *newNode = _newSoftNode(heap);
+    if (newNode == NULL) return NULL;
+    newNode->_left = node;
+    newNode->_right = otherNode;
+    newNode->_rank = node->_rank + 1;
+    // Above rank r, nodes hold more and more items: this is where keys get
+    // corrupted.
+    if (newNode->_rank <= heap->_r) newNode->_size = 1;
+    else newNode->_size = ((3 * node->_size) + 1) / 2;
+    _sift(heap, newNode);
+    return newNode;
+}
+
+/* Fills the items list of a node with those of its sons, taking each time
+ * the ones with the minimum key and corrupting them to it. Works as a DFS.
+ */
+void _sift(SoftHeap *heap, SoftNode *node) {
+    while ((node->_itemsCnt < node->_size) &&
+           ((node->_left != NULL) || (node->_right != NULL))) {
+        if ((node->_left == NULL) ||
+            ((node->_right != NULL) &&
+             (node->_left->_ckey > node->_right->_ckey))) {
+            SoftNode *tmp = node->_left;
+            node->_left = node->_right;
+            node->_right = tmp;
+        }
+        SoftNode *son = node->_left;
+        // Move the son's items here.
+        if (node->_last != NULL) node->_last->_next = son->_first;
+        else node->_first = son->_first;
+        node->_last = son->_last;
+        node->_itemsCnt += son->_itemsCnt;
+        node->_ckey = son->_ckey;
+        son->_first = NULL;
+        son->_last = NULL;
+        son->_itemsCnt = 0;
+        if ((son->_left == NULL) && (son->_right == NULL)) {
+            _freeSoftNode(heap, son);
+            node->_left = NULL;
+        } else _sift(heap, son);
+    }
+}
+
+/* Combines a tree with the following one, which must have the same rank.
+ * Returns 0 on success, -1 on failure (in which case trees are left alone).
+ */
+int _linkTrees(SoftHeap *heap, SoftTree *tree) {
+    SoftTree *next = tree->_next;
+    SoftNode *newRoot = _combine(heap, tree->_root, next->_root);
+    if (newRoot == NULL) return -1;
+    tree->_root = newRoot;
+    tree->_rank = newRoot->_rank;
+    tree->_next = next->_next;
+    if (next->_next != NULL) next->_next->_prev = tree;
+    _freeSoftTree(heap, next);
+    return 0;
+}
+
+/* Combines a tree with the following ones as long as they have the same rank,
+ * as a carry in a binary counter. Returns the resulting tree.
+ */
+SoftTree *_combineTrees(SoftHeap *heap, SoftTree *tree) {
+    while ((tree->_next != NULL) && (tree->_next->_rank == tree->_rank))
+        if (_linkTrees(heap, tree) != 0) break;
+    return tree;
+}
+
+/* Updates the suffix minimum pointers from a tree back to the first one. */
+void _updateSufMin(SoftTree *tree) {
+    while (tree != NULL) {
+        if ((tree->_next == NULL) ||
+            (tree->_root->_ckey <= tree->_next->_sufMin->_root->_ckey))
+            tree->_sufMin = tree;
+        else tree->_sufMin = tree->_next->_sufMin;
+        tree = tree->_prev;
+    }
+}
+
+/* Recursively deletes the items of a subtree. Works as a DFS.
+ * Nodes go away with the pool.
+ */
+void _eraseSoftSubtree(SoftNode *root, int opts) {
+    if (root == NULL) return;
+    _eraseSoftSubtree(root->_left, opts);
+    _eraseSoftSubtree(root->_right, opts);
+    SoftItem *currItem = root->_first;
+    while (currItem != NULL) {
+        SoftItem *nextOne = currItem->_next;
+        eraseSoftItem(currItem, opts);
+        currItem = nextOne;
+    }
+}
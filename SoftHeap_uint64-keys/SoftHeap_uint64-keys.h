@@ -0,0 +1,107 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Soft Heap
+ * library. This implementation follows the simplified soft heap by Kaplan and
+ * Zwick, uses unsigned 64-bit integers as keys and "void *s" as elements.
+ * A soft heap is a priority queue that may raise ("corrupt") the keys of some
+ * of its items to move them together, in exchange for constant amortized time
+ * insertions and deletions. Given an error rate eps in (0, 1), at most eps * n
+ * items in the heap are corrupted at any time, n being the number of
+ * insertions so far. This is what approximate selection and Chazelle's minimum
+ * spanning tree algorithm are built upon.
+ * Items are the equivalent of Fibonacci Heap nodes: they are allocated by the
+ * heap on insertion and handed over to the caller on deletion, with both
+ * their original key and the (possibly corrupted) one they were deleted with,
+ * so that corrupted items can be told apart.
+ * Functions intended to be used are marked as such, whilst other internal
+ * subroutines should not be used outside of these source files.
+ * See other comments for specific descriptions of functions and data
+ * structures.
+ * NOTE: Tree nodes are taken from a pool, grown in chunks as in pooled
+ * Fibonacci Heaps and recycled as nodes are merged and consumed. Items don't
+ * need handles, since a soft heap offers no operations on a specific item.
+ * NOTE: Items's elements could be pointers to the heap as well. A binary flag
+ * is provided to free them when total heap deletion is called.
+ * NOTE: Two heaps can be melded only if they have the same error rate.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef SOFTHEAP_UINT64_KEYS_H
+#define SOFTHEAP_UINT64_KEYS_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* This option can be passed to the delete functions to specify if also the
+ * elements in the items must be freed in the heap.
+ * If nothing is specified, only the items are freed.
+ */
+#define DELETE_FREE_DATA 0x1
+
+/* Tree nodes pools are grown in chunks of 2^SH_POOL_CHUNK_ORD nodes. */
+#define SH_POOL_CHUNK_ORD 10
+
+/* Soft Heap Item. Stores an element and its key. */
+typedef struct __softItem {
+    uint64_t key;                    // Original key.
+    uint64_t ckey;                   // Key it was deleted with.
+    void *elem;                      // Element stored in the item.
+    struct __softItem *_next;        // Next item in the same node.
+} SoftItem;
+
+/* Soft Heap Tree Node. Holds a list of items, which share a common key not
+ * smaller than any of their original ones.
+ */
+typedef struct __softNode {
+    uint64_t _ckey;                  // Common key of the items.
+    SoftItem *_first;                // Items list.
+    SoftItem *_last;
+    ulong _itemsCnt;
+    ulong _rank;
+    ulong _size;                     // Target size of the items list.
+    struct __softNode *_left;        // Sons, if present.
+    struct __softNode *_right;
+} SoftNode;
+
+/* Soft Heap Tree. Trees are kept in a list ordered by rank, each with a
+ * pointer to the one with the minimum root key among itself and those after.
+ */
+typedef struct __softTree {
+    SoftNode *_root;
+    ulong _rank;
+    struct __softTree *_prev;
+    struct __softTree *_next;
+    struct __softTree *_sufMin;
+} SoftTree;
+
+/* Soft Heap. */
+typedef struct {
+    SoftTree *_first;         // Trees list.
+    ulong _r;                 // Nodes above this rank hold more items.
+    double eps;               // Error rate.
+    ulong itemsCount;         // Counter for the items in the structure.
+    SoftNode **_chunks;       // Nodes pool.
+    ulong _chunksCnt;
+    ulong _used;
+    SoftNode *_freeNodes;     // Recycled nodes, linked through "_left".
+    SoftTree *_freeTrees;     // Recycled trees, linked through "_next".
+} SoftHeap;
+
+/* Tells whether the key of an item was corrupted when it was deleted. */
+#define shIsCorrupted(item) ((item)->ckey != (item)->key)
+
+/* Library functions. */
+SoftHeap *createSoftHeap(double eps);
+void eraseSoftHeap(SoftHeap *heap, int opts);
+void eraseSoftItem(SoftItem *item, int opts);
+int isSoftHeapEmpty(SoftHeap *heap);
+SoftItem *shInsert(SoftHeap *heap, void *elem, uint64_t key);
+SoftItem *shFindMin(SoftHeap *heap);
+uint64_t shFindMinKey(SoftHeap *heap);
+SoftItem *shDeleteMin(SoftHeap *heap);
+int shMeld(SoftHeap *heap, SoftHeap *other);
+
+#endif
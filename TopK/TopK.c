@@ -0,0 +1,155 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Top-K library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "TopK.h"
+
+/* Vector of keys compared at once when filtering batches, and its size. */
+#define TOPK_VEC_LEN 4
+typedef uint64_t TopKVec __attribute__((vector_size(TOPK_VEC_LEN * 8)));
+
+/* Declarations of internal library subroutines. */
+int _topkAdd(TopK *topk, void *elem, uint64_t key);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new Top-K operator for k elements. */
+TopK *createTopK(ulong k) {
+    if (k == 0) return NULL;
+    TopK *newTopK = calloc(1, sizeof(TopK));
+    if (newTopK == NULL) return NULL;
+    // The heap will hold at most k nodes.
+    ulong treeOrd = 1;
+    while ((treeOrd < (sizeof(ulong) * 8)) && ((1UL << treeOrd) < k))
+        treeOrd++;
+    newTopK->_heap = createFibHeap(treeOrd + 1);
+    if (newTopK->_heap == NULL) {
+        free(newTopK);
+        return NULL;
+    }
+    newTopK->_threshold = 0;
+    newTopK->k = k;
+    return newTopK;
+}
+
+/* Destroys a Top-K operator, freeing memory. */
+void eraseTopK(TopK *topk, int opts) {
+    if (topk == NULL) return;
+    eraseFibHeap(topk->_heap, opts);
+    free(topk);
+}
+
+/* Offers an element to the operator.
+ * Returns 1 if it entered the set, 0 if it didn't, -1 on failure.
+ */
+int topkPush(TopK *topk, void *elem, uint64_t key) {
+    if (topk == NULL) return -1;
+    if ((topk->_heap->nodesCount == topk->k) && (key <= topk->_threshold))
+        return 0;
+    return _topkAdd(topk, elem, key);
+}
+
+/* Offers a batch of elements to the operator. Keys are first compared to the
+ * threshold in vectors, and only those that exceed it are inserted.
+ * Returns the number of elements that entered the set (some of which may have
+ * been evicted by subsequent ones in the same batch).
+ */
+ulong topkPushBatch(TopK *topk, void **elems, const uint64_t *keys, ulong n) {
+    if ((topk == NULL) || (elems == NULL) || (keys == NULL)) return 0;
+    ulong added = 0, i = 0;
+
+    // Until the set is full, everything gets in.
+    while ((i < n) && (topk->_heap->nodesCount < topk->k)) {
+        if (_topkAdd(topk, elems[i], keys[i]) == 1) added++;
+        i++;
+    }
+
+    // Then filter whole vectors of keys against the threshold.
+    for (; (i + TOPK_VEC_LEN) <= n; i += TOPK_VEC_LEN) {
+        TopKVec keysVec, thresholdVec;
+        memcpy(&keysVec, keys + i, sizeof(TopKVec));
+        for (int j = 0; j < TOPK_VEC_LEN; j++)
+            thresholdVec[j] = topk->_threshold;
+        TopKVec mask = (TopKVec)(keysVec > thresholdVec);
+        uint64_t any = 0;
+        for (int j = 0; j < TOPK_VEC_LEN; j++) any |= mask[j];
+        if (!any) continue;
+        // Some keys could get in: check them one by one, since the threshold
+        // rises with each insertion.
+        for (int j = 0; j < TOPK_VEC_LEN; j++)
+            if (mask[j] && (keys[i + j] > topk->_threshold) &&
+                (_topkAdd(topk, elems[i + j], keys[i + j]) == 1))
+                added++;
+    }
+
+    // Leftovers.
+    for (; i < n; i++)
+        if ((keys[i] > topk->_threshold) &&
+            (_topkAdd(topk, elems[i], keys[i]) == 1))
+            added++;
+    return added;
+}
+
+/* Merges the set of an operator into another one, emptying the former.
+ * Meant to combine partial results computed by different threads.
+ * Returns 0 on success, -1 on failure.
+ */
+int topkMerge(TopK *dst, TopK *src) {
+    if ((dst == NULL) || (src == NULL)) return -1;
+    int ret = 0;
+    while (src->_heap->min != NULL) {
+        FibTreeNode *minNode = fhDeleteMin(src->_heap);
+        if (topkPush(dst, minNode->elem, minNode->key) == -1) ret = -1;
+        eraseFibTreeNode(minNode, 0);
+    }
+    src->_threshold = 0;
+    return ret;
+}
+
+/* Extracts the set from the operator in decreasing key order, emptying it.
+ * The arrays must be able to hold k entries; either one may be NULL.
+ * Returns the number of extracted elements.
+ */
+ulong topkExtract(TopK *topk, void **elems, uint64_t *keys) {
+    if (topk == NULL) return 0;
+    ulong cnt = topk->_heap->nodesCount;
+    // The heap pops keys in increasing order, so fill the arrays backwards.
+    for (ulong i = cnt; i > 0; i--) {
+        FibTreeNode *minNode = fhDeleteMin(topk->_heap);
+        if (elems != NULL) elems[i - 1] = minNode->elem;
+        if (keys != NULL) keys[i - 1] = minNode->key;
+        eraseFibTreeNode(minNode, 0);
+    }
+    topk->_threshold = 0;
+    return cnt;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Adds an element to the set, evicting the minimum if the set is full.
+ * Returns 1 on success, -1 on failure.
+ */
+int _topkAdd(TopK *topk, void *elem, uint64_t key) {
+    FibHeap *heap = topk->_heap;
+    if (heap->nodesCount < topk->k) {
+        if (fhInsert(heap, elem, key) == NULL) return -1;
+    } else {
+        // Recycle the minimum node for the new element.
+        // The element changes only once the key did, so that a failure
+        // leaves the evicted one in the set.
+        FibTreeNode *minNode = heap->min;
+        if (fhIncreaseKey(heap, minNode, key - minNode->key) == NULL)
+            return -1;
+        minNode->elem = elem;
+    }
+    if (heap->nodesCount == topk->k) topk->_threshold = heap->min->key;
+    return 1;
+}
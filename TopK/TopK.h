@@ -0,0 +1,49 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Top-K library,
+ * a streaming operator that keeps the K elements with the greatest keys seen
+ * in a stream. It is built on top of the Fibonacci Heap library, used as a
+ * bounded min-heap of the K greatest keys: its minimum is the threshold that
+ * a new key has to exceed to enter the set.
+ * Input can be fed one element at a time or in batches. Batches are filtered
+ * against the threshold a vector of keys at a time, so that only the few keys
+ * that could enter the set touch the heap.
+ * Partial results computed on different threads, each with its own operator,
+ * can be merged into a single one.
+ * NOTE: Elements are never freed by the operator, apart from a total deletion
+ * with the DELETE_FREE_DATA flag. Elements that are rejected or evicted are
+ * simply forgotten.
+ * NOTE: Among elements with equal keys, those that came first are kept.
+ * NOTE: A single operator is not thread-safe.
+ * NOTE: Vector comparisons use GNU C vector extensions, which are compiled to
+ * SIMD instructions when the target supports them.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef TOPK_H
+#define TOPK_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Top-K operator. Keeps the set in a heap, and caches its minimum key. */
+typedef struct {
+    FibHeap *_heap;         // Min-heap of the greatest keys seen.
+    uint64_t _threshold;    // Minimum key in the set, once full.
+    ulong k;                // Maximum size of the set.
+} TopK;
+
+/* Library functions. */
+TopK *createTopK(ulong k);
+void eraseTopK(TopK *topk, int opts);
+int topkPush(TopK *topk, void *elem, uint64_t key);
+ulong topkPushBatch(TopK *topk, void **elems, const uint64_t *keys, ulong n);
+int topkMerge(TopK *dst, TopK *src);
+ulong topkExtract(TopK *topk, void **elems, uint64_t *keys);
+
+#endif
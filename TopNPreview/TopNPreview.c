@@ -0,0 +1,152 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Top-N Preview library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+
+#include "TopNPreview.h"
+
+/* Declarations of internal library subroutines. */
+TNPSnapshot *_newSnapshot(ulong n);
+void _eraseSnapshot(TNPSnapshot *snapshot);
+void _reclaim(TopNPreview *preview);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new Top-N Preview, for snapshots of n pairs and
+ * a given number of reader threads. The initial snapshot is empty.
+ */
+TopNPreview *createTopNPreview(ulong n, ulong readersCnt) {
+    if ((n == 0) || (readersCnt == 0)) return NULL;
+    TopNPreview *newPreview = calloc(1, sizeof(TopNPreview));
+    if (newPreview == NULL) return NULL;
+    newPreview->_readers = aligned_alloc(TNP_CACHE_LINE,
+                                         readersCnt * sizeof(TNPReaderSlot));
+    TNPSnapshot *first = _newSnapshot(n);
+    if ((newPreview->_readers == NULL) || (first == NULL)) {
+        free(newPreview->_readers);
+        _eraseSnapshot(first);
+        free(newPreview);
+        return NULL;
+    }
+    for (ulong i = 0; i < readersCnt; i++)
+        atomic_init(&((newPreview->_readers)[i]._epoch), 0);
+    newPreview->readersCount = readersCnt;
+    atomic_init(&(newPreview->_current), first);
+    atomic_init(&(newPreview->_epoch), 1);
+    newPreview->_retired = NULL;
+    newPreview->_retiredCnt = 0;
+    newPreview->_retiredCap = 0;
+    newPreview->_version = 0;
+    newPreview->n = n;
+    return newPreview;
+}
+
+/* Destroys a Top-N Preview, freeing memory. No reader must be reading. */
+void eraseTopNPreview(TopNPreview *preview) {
+    if (preview == NULL) return;
+    for (ulong i = 0; i < preview->_retiredCnt; i++)
+        _eraseSnapshot((preview->_retired)[i]._snapshot);
+    _eraseSnapshot(atomic_load(&(preview->_current)));
+    free(preview->_retired);
+    free(preview->_readers);
+    free(preview);
+}
+
+/* Publishes a new snapshot of the smallest keys in a heap, which must be
+ * owned by the calling thread. Never waits for readers.
+ * Returns 0 on success, -1 on failure (the previous snapshot stays valid).
+ */
+int tnpPublish(TopNPreview *preview, FibHeap *heap) {
+    if ((preview == NULL) || (heap == NULL)) return -1;
+    // Make room to retire the current snapshot first, so that nothing has to
+    // be undone afterwards.
+    if (preview->_retiredCnt == preview->_retiredCap) {
+        ulong newCap = preview->_retiredCap > 0 ?
+                       2 * preview->_retiredCap : preview->readersCount + 1;
+        TNPRetired *newRetired = reallocarray(preview->_retired, newCap,
+                                              sizeof(TNPRetired));
+        if (newRetired == NULL) return -1;
+        preview->_retired = newRetired;
+        preview->_retiredCap = newCap;
+    }
+    TNPSnapshot *newSnapshot = _newSnapshot(preview->n);
+    if (newSnapshot == NULL) return -1;
+    newSnapshot->count = fhPeekSmallest(heap, preview->n, newSnapshot->keys,
+                                        newSnapshot->elems);
+    newSnapshot->version = ++(preview->_version);
+
+    // Swap the snapshots, then close the epoch: readers that may have the old
+    // one announced this epoch or an older one.
+    TNPSnapshot *old = atomic_exchange(&(preview->_current), newSnapshot);
+    TNPRetired *retired = &((preview->_retired)[(preview->_retiredCnt)++]);
+    retired->_snapshot = old;
+    retired->_epoch = atomic_fetch_add(&(preview->_epoch), 1);
+    _reclaim(preview);
+    return 0;
+}
+
+/* Starts a read from a given reader slot, returning the current snapshot,
+ * which stays valid until "tnpReadEnd" is called.
+ */
+const TNPSnapshot *tnpReadBegin(TopNPreview *preview, ulong reader) {
+    if ((preview == NULL) || (reader >= preview->readersCount)) return NULL;
+    // Announce the epoch before looking at the snapshot, so that the writer
+    // either sees the announcement or has already swapped the pointer.
+    atomic_store(&((preview->_readers)[reader]._epoch),
+                 atomic_load(&(preview->_epoch)));
+    return atomic_load(&(preview->_current));
+}
+
+/* Ends a read from a given reader slot. */
+void tnpReadEnd(TopNPreview *preview, ulong reader) {
+    if ((preview == NULL) || (reader >= preview->readersCount)) return;
+    atomic_store_explicit(&((preview->_readers)[reader]._epoch), 0,
+                          memory_order_release);
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Allocates an empty snapshot for up to n pairs. */
+TNPSnapshot *_newSnapshot(ulong n) {
+    TNPSnapshot *snapshot = calloc(1, sizeof(TNPSnapshot));
+    if (snapshot == NULL) return NULL;
+    snapshot->keys = calloc(n, sizeof(uint64_t));
+    snapshot->elems = calloc(n, sizeof(void *));
+    if ((snapshot->keys == NULL) || (snapshot->elems == NULL)) {
+        _eraseSnapshot(snapshot);
+        return NULL;
+    }
+    return snapshot;
+}
+
+/* Frees a snapshot. */
+void _eraseSnapshot(TNPSnapshot *snapshot) {
+    if (snapshot == NULL) return;
+    free(snapshot->keys);
+    free(snapshot->elems);
+    free(snapshot);
+}
+
+/* Frees the retired snapshots that no reader can hold anymore, i.e. those
+ * replaced in an epoch older than all the ones announced by readers.
+ */
+void _reclaim(TopNPreview *preview) {
+    uint64_t oldest = UINT64_MAX;
+    for (ulong i = 0; i < preview->readersCount; i++) {
+        uint64_t epoch = atomic_load(&((preview->_readers)[i]._epoch));
+        if ((epoch != 0) && (epoch < oldest)) oldest = epoch;
+    }
+    ulong kept = 0;
+    for (ulong i = 0; i < preview->_retiredCnt; i++) {
+        if ((preview->_retired)[i]._epoch < oldest)
+            _eraseSnapshot((preview->_retired)[i]._snapshot);
+        else (preview->_retired)[kept++] = (preview->_retired)[i];
+    }
+    preview->_retiredCnt = kept;
+}
@@ -0,0 +1,80 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Top-N Preview
+ * library, which lets many reader threads look at the N smallest keys of a
+ * Fibonacci Heap (e.g. the next deadlines of a timer queue) without ever
+ * locking it or stalling the thread that owns it.
+ * The owner of the heap (the "writer") periodically publishes an immutable
+ * snapshot of its N smallest (key, element) pairs, taken with
+ * "fhPeekSmallest", by swapping a single pointer. Readers get the current
+ * snapshot between "tnpReadBegin" and "tnpReadEnd", and see a consistent view
+ * with no locks, since snapshots never change once published.
+ * Old snapshots are reclaimed by the writer with epochs, as in RCU: each
+ * reader has a slot where it announces the epoch in which it started reading,
+ * and a replaced snapshot is freed only when no reader could still hold it.
+ * The writer never waits for readers: snapshots that are still in use are
+ * just kept, and freed by later publications.
+ * NOTE: Each reader thread must use its own slot, identified by an index in
+ * [0, readersCount). Reads can't be nested.
+ * NOTE: Elements are copied as they are, so pointers in the snapshot are valid
+ * only as long as their targets are, which is up to the writer.
+ * NOTE: This library requires the Fibonacci Heap library and C11 atomics.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef TOPNPREVIEW_H
+#define TOPNPREVIEW_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Size of a cache line, so that reader slots don't share one. */
+#define TNP_CACHE_LINE 64
+
+/* Snapshot of the smallest keys in a heap, in ascending order. */
+typedef struct {
+    uint64_t version;           // Number of the publication.
+    ulong count;                // Number of valid pairs.
+    uint64_t *keys;
+    void **elems;
+} TNPSnapshot;
+
+/* Reader slot: epoch in which the reader started, or 0 if it's not reading.
+ */
+typedef struct {
+    _Alignas(TNP_CACHE_LINE) _Atomic uint64_t _epoch;
+} TNPReaderSlot;
+
+/* Replaced snapshot, waiting to be freed. */
+typedef struct {
+    TNPSnapshot *_snapshot;
+    uint64_t _epoch;            // Epoch in which it was replaced.
+} TNPRetired;
+
+/* Top-N Preview. */
+typedef struct {
+    _Atomic(TNPSnapshot *) _current;
+    _Atomic uint64_t _epoch;    // Global epoch, starting from 1.
+    TNPReaderSlot *_readers;
+    ulong readersCount;
+    TNPRetired *_retired;       // Writer only.
+    ulong _retiredCnt;
+    ulong _retiredCap;
+    uint64_t _version;          // Writer only.
+    ulong n;                    // Maximum size of snapshots.
+} TopNPreview;
+
+/* Library functions. */
+TopNPreview *createTopNPreview(ulong n, ulong readersCnt);
+void eraseTopNPreview(TopNPreview *preview);
+int tnpPublish(TopNPreview *preview, FibHeap *heap);
+const TNPSnapshot *tnpReadBegin(TopNPreview *preview, ulong reader);
+void tnpReadEnd(TopNPreview *preview, ulong reader);
+
+#endif
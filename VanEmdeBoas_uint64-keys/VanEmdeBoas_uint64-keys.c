@@ -0,0 +1,479 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the van Emde Boas Heap library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+
+#include "VanEmdeBoas_uint64-keys.h"
+
+/* Initial size of hash tables (must be a power of 2). */
+#define VEB_TABLE_INIT_SIZE 4
+
+/* Declarations of internal library subroutines. */
+uint64_t _vebHash(uint64_t x);
+VEBNode *_vebNew(unsigned char bits);
+void _vebFree(VEBNode *node);
+int _vebIsEmpty(VEBNode *node);
+uint64_t _vebMinOf(VEBNode *node);
+uint64_t _vebMaxOf(VEBNode *node);
+int _vebInsert(VEBNode *node, uint64_t x);
+void _vebDelete(VEBNode *node, uint64_t x);
+int _vebSucc(VEBNode *node, uint64_t x, uint64_t *succ);
+VEBNode *_getCluster(VEBNode *node, uint64_t high);
+int _putCluster(VEBNode *node, uint64_t high, VEBNode *cluster);
+void _dropCluster(VEBNode *node, uint64_t high);
+VEBKeyEntry *_findKey(VEBHeap *heap, uint64_t key);
+VEBKeyEntry *_addKey(VEBHeap *heap, uint64_t key);
+void _removeKey(VEBHeap *heap, VEBKeyEntry *entry);
+VEBItem *_addItem(VEBHeap *heap, VEBItem *item);
+
+// LIBRARY FUNCTIONS //
+/* Creates and initializes a new van Emde Boas Heap for keys in
+ * [0, 2^universeBits), with universeBits in [1, 64].
+ */
+VEBHeap *createVEBHeap(unsigned char universeBits) {
+    if ((universeBits == 0) || (universeBits > 64)) return NULL;
+    VEBHeap *newHeap = calloc(1, sizeof(VEBHeap));
+    if (newHeap == NULL) return NULL;
+    newHeap->_tree = _vebNew(universeBits);
+    newHeap->_keys = calloc(VEB_TABLE_INIT_SIZE, sizeof(VEBKeyEntry));
+    if ((newHeap->_tree == NULL) || (newHeap->_keys == NULL)) {
+        free(newHeap->_tree);
+        free(newHeap->_keys);
+        free(newHeap);
+        return NULL;
+    }
+    newHeap->_keysSize = VEB_TABLE_INIT_SIZE;
+    newHeap->_keysUsed = 0;
+    newHeap->bits = universeBits;
+    newHeap->itemsCount = 0;
+    return newHeap;
+}
+
+/* Destroys a van Emde Boas Heap, freeing memory. */
+void eraseVEBHeap(VEBHeap *heap, int opts) {
+    if (heap == NULL) return;
+    for (ulong i = 0; i < heap->_keysSize; i++) {
+        VEBItem *currItem = (heap->_keys)[i].first;
+        while (currItem != NULL) {
+            VEBItem *nextOne = currItem->_next;
+            eraseVEBItem(currItem, opts);
+            currItem = nextOne;
+        }
+    }
+    free(heap->_keys);
+    _vebFree(heap->_tree);
+    free(heap);
+}
+
+/* Deletes a given item, freeing memory. */
+void eraseVEBItem(VEBItem *item, int opts) {
+    if (item == NULL) return;
+    if (opts & DELETE_FREE_DATA) free(item->elem);
+    free(item);
+}
+
+/* Tells whether a given heap is empty or not. */
+int isVEBHeapEmpty(VEBHeap *heap) {
+    if (heap == NULL) return -1;
+    return heap->itemsCount == 0;
+}
+
+/* Creates a new item and adds it to the heap.
+ * Returns NULL if the key is outside of the universe, or on failure.
+ */
+VEBItem *vebInsert(VEBHeap *heap, void *elem, uint64_t key) {
+    if (heap == NULL) return NULL;
+    if ((heap->bits < 64) && ((key >> heap->bits) != 0)) return NULL;
+    VEBItem *newItem = calloc(1, sizeof(VEBItem));
+    if (newItem == NULL) return NULL;
+    newItem->key = key;
+    newItem->elem = elem;
+    if (_addItem(heap, newItem) == NULL) {
+        free(newItem);
+        return NULL;
+    }
+    return newItem;
+}
+
+/* Returns an item with the minimum key, without deleting it. */
+VEBItem *vebFindMin(VEBHeap *heap) {
+    if ((heap == NULL) || (heap->itemsCount == 0)) return NULL;
+    return _findKey(heap, _vebMinOf(heap->_tree))->first;
+}
+
+/* Deletes an item with the minimum key from the heap and returns it. */
+VEBItem *vebDeleteMin(VEBHeap *heap) {
+    return vebDelete(heap, vebFindMin(heap));
+}
+
+/* Deletes an item from the heap and returns it. */
+VEBItem *vebDelete(VEBHeap *heap, VEBItem *item) {
+    if ((heap == NULL) || (item == NULL)) return NULL;
+    if (item->_prev != NULL) item->_prev->_next = item->_next;
+    if (item->_next != NULL) item->_next->_prev = item->_prev;
+    VEBKeyEntry *entry = _findKey(heap, item->key);
+    if (entry->first == item) entry->first = item->_next;
+    if (entry->first == NULL) {
+        // That was the last item with this key.
+        _removeKey(heap, entry);
+        _vebDelete(heap->_tree, item->key);
+    }
+    item->_next = NULL;
+    item->_prev = NULL;
+    heap->itemsCount--;
+    return item;
+}
+
+/* Decreases item's key of dec (key -= dec), updating the heap structure.
+ * Returns a pointer to the item, or NULL if dec is greater than its key or on
+ * failure (in which case the item is lost).
+ */
+VEBItem *vebDecreaseKey(VEBHeap *heap, VEBItem *item, uint64_t dec) {
+    if ((heap == NULL) || (item == NULL) || (dec > item->key)) return NULL;
+    if (dec == 0) return item;
+    vebDelete(heap, item);
+    item->key -= dec;
+    return _addItem(heap, item);
+}
+
+/* Increases item's key of inc (key += inc), updating the heap structure.
+ * Returns a pointer to the item, or NULL if the new key would be outside of
+ * the universe or on failure (in which case the item is lost).
+ */
+VEBItem *vebIncreaseKey(VEBHeap *heap, VEBItem *item, uint64_t inc) {
+    if ((heap == NULL) || (item == NULL)) return NULL;
+    if (inc > UINT64_MAX - item->key) return NULL;
+    if ((heap->bits < 64) && (((item->key + inc) >> heap->bits) != 0))
+        return NULL;
+    if (inc == 0) return item;
+    vebDelete(heap, item);
+    item->key += inc;
+    return _addItem(heap, item);
+}
+
+/* Finds the smallest key in the heap strictly greater than a given one.
+ * Returns 0 and stores it in succ if there is one, -1 otherwise.
+ */
+int vebSuccessor(VEBHeap *heap, uint64_t key, uint64_t *succ) {
+    if ((heap == NULL) || (succ == NULL)) return -1;
+    if ((heap->bits < 64) && ((key >> heap->bits) != 0)) return -1;
+    return _vebSucc(heap->_tree, key, succ) ? 0 : -1;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Scrambles a 64-bit integer (splitmix64 finalizer). */
+uint64_t _vebHash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/* Creates a new, empty tree for a universe of 2^bits keys. */
+VEBNode *_vebNew(unsigned char bits) {
+    VEBNode *newNode = calloc(1, sizeof(VEBNode));
+    if (newNode == NULL) return NULL;
+    newNode->bits = bits;
+    newNode->empty = 1;
+    newNode->summary = NULL;
+    newNode->_clusters = NULL;
+    newNode->_clustersSize = 0;
+    newNode->_clustersUsed = 0;
+    return newNode;
+}
+
+/* Recursively deletes a tree, freeing memory. */
+void _vebFree(VEBNode *node) {
+    if (node == NULL) return;
+    for (ulong i = 0; i < node->_clustersSize; i++)
+        _vebFree((node->_clusters)[i].node);
+    free(node->_clusters);
+    _vebFree(node->summary);
+    free(node);
+}
+
+/* Tells whether a tree is empty. */
+int _vebIsEmpty(VEBNode *node) {
+    if (node->bits <= VEB_BASE_BITS) return node->bitmap == 0;
+    return node->empty;
+}
+
+/* Returns the minimum key in a non-empty tree. */
+uint64_t _vebMinOf(VEBNode *node) {
+    if (node->bits <= VEB_BASE_BITS)
+        return (uint64_t)__builtin_ctzll(node->bitmap);
+    return node->min;
+}
+
+/* Returns the maximum key in a non-empty tree. */
+uint64_t _vebMaxOf(VEBNode *node) {
+    if (node->bits <= VEB_BASE_BITS)
+        return 63 - (uint64_t)__builtin_clzll(node->bitmap);
+    return node->max;
+}
+
+/* Adds a key, which must not be there, to a tree.
+ * Returns 0 on success, -1 on failure.
+ */
+int _vebInsert(VEBNode *node, uint64_t x) {
+    if (node->bits <= VEB_BASE_BITS) {
+        node->bitmap |= 1ULL << x;
+        return 0;
+    }
+    if (node->empty) {
+        node->min = x;
+        node->max = x;
+        node->empty = 0;
+        return 0;
+    }
+    // The smaller of the two keys stays here, the other one goes down.
+    uint64_t down = x < node->min ? node->min : x;
+    unsigned char lowBits = node->bits / 2;
+    uint64_t high = down >> lowBits;
+    uint64_t low = down & ((1ULL << lowBits) - 1);
+    VEBNode *cluster = _getCluster(node, high);
+    if (cluster == NULL) {
+        // Allocate all that is needed before changing anything.
+        if (node->summary == NULL) {
+            node->summary = _vebNew(node->bits - lowBits);
+            if (node->summary == NULL) return -1;
+        }
+        cluster = _vebNew(lowBits);
+        if (cluster == NULL) return -1;
+        if (_putCluster(node, high, cluster) != 0) {
+            free(cluster);
+            return -1;
+        }
+        if (_vebInsert(node->summary, high) != 0) {
+            _dropCluster(node, high);
+            return -1;
+        }
+    }
+    if (_vebInsert(cluster, low) != 0) return -1;
+    if (x < node->min) node->min = x;
+    if (x > node->max) node->max = x;
+    return 0;
+}
+
+/* Deletes a key, which must be there, from a tree. Clusters are dropped as
+ * soon as they get empty.
+ */
+void _vebDelete(VEBNode *node, uint64_t x) {
+    if (node->bits <= VEB_BASE_BITS) {
+        node->bitmap &= ~(1ULL << x);
+        return;
+    }
+    if (node->min == node->max) {
+        node->empty = 1;
+        return;
+    }
+    unsigned char lowBits = node->bits / 2;
+    if (x == node->min) {
+        // The next key takes the place of the minimum, so it goes away from
+        // its cluster.
+        uint64_t high = _vebMinOf(node->summary);
+        x = (high << lowBits) | _vebMinOf(_getCluster(node, high));
+        node->min = x;
+    }
+    uint64_t high = x >> lowBits;
+    VEBNode *cluster = _getCluster(node, high);
+    _vebDelete(cluster, x & ((1ULL << lowBits) - 1));
+    if (_vebIsEmpty(cluster)) {
+        _dropCluster(node, high);
+        _vebDelete(node->summary, high);
+        if (x == node->max) {
+            if (_vebIsEmpty(node->summary)) node->max = node->min;
+            else {
+                uint64_t maxHigh = _vebMaxOf(node->summary);
+                node->max = (maxHigh << lowBits) |
+                            _vebMaxOf(_getCluster(node, maxHigh));
+            }
+        }
+    } else if (x == node->max)
+        node->max = (high << lowBits) | _vebMaxOf(cluster);
+}
+
+/* Finds the smallest key in a tree strictly greater than x.
+ * Returns 1 and stores it in succ if there is one, 0 otherwise.
+ */
+int _vebSucc(VEBNode *node, uint64_t x, uint64_t *succ) {
+    if (node->bits <= VEB_BASE_BITS) {
+        if (x >= 63) return 0;
+        uint64_t above = node->bitmap & (~0ULL << (x + 1));
+        if (above == 0) return 0;
+        *succ = (uint64_t)__builtin_ctzll(above);
+        return 1;
+    }
+    if (node->empty) return 0;
+    if (x < node->min) {
+        *succ = node->min;
+        return 1;
+    }
+    unsigned char lowBits = node->bits / 2;
+    uint64_t high = x >> lowBits;
+    uint64_t low = x & ((1ULL << lowBits) - 1);
+    VEBNode *cluster = _getCluster(node, high);
+    uint64_t found;
+    if ((cluster != NULL) && (low < _vebMaxOf(cluster))) {
+        _vebSucc(cluster, low, &found);
+        *succ = (high << lowBits) | found;
+        return 1;
+    }
+    if ((node->summary != NULL) && _vebSucc(node->summary, high, &found)) {
+        *succ = (found << lowBits) | _vebMinOf(_getCluster(node, found));
+        return 1;
+    }
+    return 0;
+}
+
+/* Looks up a cluster of a tree. Returns NULL if it is empty. */
+VEBNode *_getCluster(VEBNode *node, uint64_t high) {
+    if (node->_clustersSize == 0) return NULL;
+    ulong mask = node->_clustersSize - 1;
+    ulong pos = _vebHash(high) & mask;
+    while ((node->_clusters)[pos].node != NULL) {
+        if ((node->_clusters)[pos].high == high)
+            return (node->_clusters)[pos].node;
+        pos = (pos + 1) & mask;
+    }
+    return NULL;
+}
+
+/* Adds a cluster to a tree's table, growing it if needed.
+ * Returns 0 on success, -1 on failure.
+ */
+int _putCluster(VEBNode *node, uint64_t high, VEBNode *cluster) {
+    if ((node->_clustersUsed + 1) * 4 > node->_clustersSize * 3) {
+        ulong newSize = node->_clustersSize > 0 ? node->_clustersSize * 2 :
+                                                  VEB_TABLE_INIT_SIZE;
+        VEBCluster *newTable = calloc(newSize, sizeof(VEBCluster));
+        if (newTable == NULL) return -1;
+        for (ulong i = 0; i < node->_clustersSize; i++) {
+            if ((node->_clusters)[i].node == NULL) continue;
+            ulong pos = _vebHash((node->_clusters)[i].high) & (newSize - 1);
+            while (newTable[pos].node != NULL) pos = (pos + 1) & (newSize - 1);
+            newTable[pos] = (node->_clusters)[i];
+        }
+        free(node->_clusters);
+        node->_clusters = newTable;
+        node->_clustersSize = newSize;
+    }
+    ulong mask = node->_clustersSize - 1;
+    ulong pos = _vebHash(high) & mask;
+    while ((node->_clusters)[pos].node != NULL) pos = (pos + 1) & mask;
+    (node->_clusters)[pos].high = high;
+    (node->_clusters)[pos].node = cluster;
+    node->_clustersUsed++;
+    return 0;
+}
+
+/* Removes a cluster from a tree's table and frees it. Following entries are
+ * shifted back, so that no tombstones are needed.
+ */
+void _dropCluster(VEBNode *node, uint64_t high) {
+    ulong mask = node->_clustersSize - 1;
+    ulong pos = _vebHash(high) & mask;
+    while ((node->_clusters)[pos].high != high) pos = (pos + 1) & mask;
+    _vebFree((node->_clusters)[pos].node);
+    (node->_clusters)[pos].node = NULL;
+    node->_clustersUsed--;
+    ulong next = (pos + 1) & mask;
+    while ((node->_clusters)[next].node != NULL) {
+        ulong home = _vebHash((node->_clusters)[next].high) & mask;
+        // Move the entry back if its home isn't between the hole and it.
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            (node->_clusters)[pos] = (node->_clusters)[next];
+            (node->_clusters)[next].node = NULL;
+            pos = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
+
+/* Looks up the items list of a key. Returns NULL if there is none. */
+VEBKeyEntry *_findKey(VEBHeap *heap, uint64_t key) {
+    ulong mask = heap->_keysSize - 1;
+    ulong pos = _vebHash(key) & mask;
+    while ((heap->_keys)[pos].first != NULL) {
+        if ((heap->_keys)[pos].key == key) return &((heap->_keys)[pos]);
+        pos = (pos + 1) & mask;
+    }
+    return NULL;
+}
+
+/* Adds an entry for a key, growing the table if needed. The entry must be
+ * filled by the caller. Returns NULL on failure.
+ */
+VEBKeyEntry *_addKey(VEBHeap *heap, uint64_t key) {
+    if ((heap->_keysUsed + 1) * 4 > heap->_keysSize * 3) {
+        ulong newSize = heap->_keysSize * 2;
+        VEBKeyEntry *newTable = calloc(newSize, sizeof(VEBKeyEntry));
+        if (newTable == NULL) return NULL;
+        for (ulong i = 0; i < heap->_keysSize; i++) {
+            if ((heap->_keys)[i].first == NULL) continue;
+            ulong pos = _vebHash((heap->_keys)[i].key) & (newSize - 1);
+            while (newTable[pos].first != NULL) pos = (pos + 1) & (newSize - 1);
+            newTable[pos] = (heap->_keys)[i];
+        }
+        free(heap->_keys);
+        heap->_keys = newTable;
+        heap->_keysSize = newSize;
+    }
+    ulong mask = heap->_keysSize - 1;
+    ulong pos = _vebHash(key) & mask;
+    while ((heap->_keys)[pos].first != NULL) pos = (pos + 1) & mask;
+    (heap->_keys)[pos].key = key;
+    heap->_keysUsed++;
+    return &((heap->_keys)[pos]);
+}
+
+/* Removes an entry from the keys table, shifting following entries back. */
+void _removeKey(VEBHeap *heap, VEBKeyEntry *entry) {
+    ulong mask = heap->_keysSize - 1;
+    ulong pos = (ulong)(entry - heap->_keys);
+    (heap->_keys)[pos].first = NULL;
+    heap->_keysUsed--;
+    ulong next = (pos + 1) & mask;
+    while ((heap->_keys)[next].first != NULL) {
+        ulong home = _vebHash((heap->_keys)[next].key) & mask;
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            (heap->_keys)[pos] = (heap->_keys)[next];
+            (heap->_keys)[next].first = NULL;
+            pos = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
+
+/* Adds an existing item to the heap. Returns NULL on failure. */
+VEBItem *_addItem(VEBHeap *heap, VEBItem *item) {
+    item->_prev = NULL;
+    VEBKeyEntry *entry = _findKey(heap, item->key);
+    if (entry == NULL) {
+        // New key: add it to the tree too.
+        entry = _addKey(heap, item->key);
+        if (entry == NULL) return NULL;
+        if (_vebInsert(heap->_tree, item->key) != 0) {
+            entry->first = item;
+            _removeKey(heap, entry);
+            return NULL;
+        }
+        item->_next = NULL;
+    } else {
+        item->_next = entry->first;
+        entry->first->_prev = item;
+    }
+    entry->first = item;
+    heap->itemsCount++;
+    return item;
+}
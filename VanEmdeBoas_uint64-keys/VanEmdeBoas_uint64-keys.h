@@ -0,0 +1,108 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the van Emde Boas
+ * Heap library, a priority queue for integer keys in a bounded universe
+ * [0, 2^bits), with bits given at creation. Keys are unsigned 64-bit
+ * integers and elements are "void *s", as in the Fibonacci Heap, and the
+ * same operations are offered, plus successor queries.
+ * The set of distinct keys is kept in a van Emde Boas tree, so that
+ * insertions, deletions and successor queries take O(log log U) time:
+ * - each tree node of a universe of 2^k keys stores its minimum and maximum
+ *   keys, a summary tree of 2^(k/2) keys telling which clusters are not
+ *   empty, and the clusters themselves, i.e. trees of 2^(k/2) keys each;
+ * - clusters are kept in a hash table with open addressing, and only while
+ *   they are not empty, so memory is proportional to the number of keys
+ *   instead of the size of the universe;
+ * - trees of at most 64 keys are single 64-bit bitmaps.
+ * Elements with the same key are kept in a list for that key, found through
+ * a hash table. The structure hands out items, which work as Fibonacci Heap
+ * nodes: the ones returned by insertions can be used to modify or delete
+ * elements, and the ones returned by deletions belong to the caller.
+ * Functions intended to be used are marked as such, whilst other internal
+ * subroutines should not be used outside of these source files.
+ * See other comments for specific descriptions of functions and data
+ * structures.
+ * NOTE: Keys outside of the universe are rejected, i.e. the operations that
+ * get one fail.
+ * NOTE: Items's elements could be pointers to the heap as well. A binary flag
+ * is provided to free them when total heap deletion is called.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef VANEMDEBOAS_UINT64_KEYS_H
+#define VANEMDEBOAS_UINT64_KEYS_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* This option can be passed to the delete functions to specify if also the
+ * elements in the items must be freed in the heap.
+ * If nothing is specified, only the items are freed.
+ */
+#define DELETE_FREE_DATA 0x1
+
+/* Trees of a universe of at most 2^VEB_BASE_BITS keys are plain bitmaps. */
+#define VEB_BASE_BITS 6
+
+/* Heap item. Stores an element and its key. */
+typedef struct __vebItem {
+    uint64_t key;                    // Keys in [0, 2^bits).
+    void *elem;                      // Element stored in the item.
+    struct __vebItem *_next;         // Other items with the same key.
+    struct __vebItem *_prev;
+} VEBItem;
+
+/* Entry of a hash table of clusters. */
+typedef struct {
+    uint64_t high;                   // Cluster number.
+    struct __vebNode *node;          // NULL for empty entries.
+} VEBCluster;
+
+/* Entry of the hash table of keys. */
+typedef struct {
+    uint64_t key;
+    VEBItem *first;                  // NULL for empty entries.
+} VEBKeyEntry;
+
+/* van Emde Boas tree node, for a universe of 2^bits keys. The minimum is
+ * stored only here, not in the clusters.
+ */
+typedef struct __vebNode {
+    uint64_t min;
+    uint64_t max;
+    uint64_t bitmap;                 // Base trees only.
+    struct __vebNode *summary;       // Non-empty clusters.
+    VEBCluster *_clusters;           // Hash table of non-empty clusters.
+    ulong _clustersSize;             // A power of 2.
+    ulong _clustersUsed;
+    unsigned char bits;
+    unsigned char empty;
+} VEBNode;
+
+/* van Emde Boas Heap. */
+typedef struct {
+    VEBNode *_tree;           // Tree of distinct keys.
+    VEBKeyEntry *_keys;       // Hash table of items lists, by key.
+    ulong _keysSize;          // A power of 2.
+    ulong _keysUsed;
+    unsigned char bits;       // Keys are in [0, 2^bits).
+    ulong itemsCount;         // Counter for the items in the structure.
+} VEBHeap;
+
+/* Library functions. */
+VEBHeap *createVEBHeap(unsigned char universeBits);
+void eraseVEBHeap(VEBHeap *heap, int opts);
+void eraseVEBItem(VEBItem *item, int opts);
+int isVEBHeapEmpty(VEBHeap *heap);
+VEBItem *vebInsert(VEBHeap *heap, void *elem, uint64_t key);
+VEBItem *vebFindMin(VEBHeap *heap);
+VEBItem *vebDeleteMin(VEBHeap *heap);
+VEBItem *vebDelete(VEBHeap *heap, VEBItem *item);
+VEBItem *vebDecreaseKey(VEBHeap *heap, VEBItem *item, uint64_t dec);
+VEBItem *vebIncreaseKey(VEBHeap *heap, VEBItem *item, uint64_t inc);
+int vebSuccessor(VEBHeap *heap, uint64_t key, uint64_t *succ);
+
+#endif
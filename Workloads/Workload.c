@@ -0,0 +1,555 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Main source file for the Workload library.
+ * See the header file for a description of the library.
+ * See comments below for a brief description of what each function does.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "Workload.h"
+
+/* Maximum length of a trace line. */
+#define WL_LINE_LEN 128
+
+/* Names of histograms in profile files. */
+static const char *_wlOpNames[WL_OP_TYPES] = {"insert", "deletemin", "delete",
+                                              "decrease", "increase"};
+
+/* Declarations of internal library subroutines. */
+int _wlParseNum(char **str, uint64_t *num);
+ulong _wlBin(uint64_t value);
+void _wlMergeSegments(WLProfile *profile);
+int _wlSaveHist(FILE *file, const char *name, const ulong *hist);
+int _wlLoadHist(FILE *file, const char *name, ulong *hist);
+ulong _wlSegmentEnd(WLGenerator *gen, ulong segment);
+uint64_t _wlRandom(uint64_t *state);
+uint64_t _wlDraw(WLGenerator *gen, const ulong *hist);
+int _wlAddLive(WLGenerator *gen, FibTreeNode *node);
+void _wlCompactLive(WLGenerator *gen);
+FibTreeNode *_wlPickTarget(WLGenerator *gen, const ulong *ages);
+
+// LIBRARY FUNCTIONS //
+/* Reads the next operation from a trace, counting lines in lineNum (which
+ * can be NULL).
+ * Returns 1 if an operation was read, 0 at the end of the trace, -1 if a line
+ * is malformed (lineNum then points to it).
+ */
+int wlReadOp(FILE *trace, WLOp *op, ulong *lineNum) {
+    if ((trace == NULL) || (op == NULL)) return -1;
+    ulong localNum = 0;
+    if (lineNum == NULL) lineNum = &localNum;
+    char line[WL_LINE_LEN];
+    while (fgets(line, WL_LINE_LEN, trace) != NULL) {
+        (*lineNum)++;
+        if ((strchr(line, '\n') == NULL) && !feof(trace)) return -1;
+        char *str = line;
+        while (isspace((unsigned char)*str)) str++;
+        if ((*str == '\0') || (*str == '#')) continue;
+        char type = *(str++);
+        op->id = 0;
+        op->arg = 0;
+        int ok;
+        switch (type) {
+        case 'i':
+            op->type = WL_INSERT;
+            ok = !_wlParseNum(&str, &(op->id)) &&
+                 !_wlParseNum(&str, &(op->arg));
+            break;
+        case 'm':
+            op->type = WL_DELETE_MIN;
+            ok = 1;
+            break;
+        case 'x':
+            op->type = WL_DELETE;
+            ok = !_wlParseNum(&str, &(op->id));
+            break;
+        case 'd':
+        case 'u':
+            op->type = type == 'd' ? WL_DECREASE : WL_INCREASE;
+            ok = !_wlParseNum(&str, &(op->id)) &&
+                 !_wlParseNum(&str, &(op->arg));
+            break;
+        default:
+            ok = 0;
+        }
+        while (isspace((unsigned char)*str)) str++;
+        return ok && (*str == '\0') ? 1 : -1;
+    }
+    return ferror(trace) ? -1 : 0;
+}
+
+/* Writes an operation to a trace. Returns 0 on success, -1 on failure. */
+int wlWriteOp(FILE *trace, const WLOp *op) {
+    if ((trace == NULL) || (op == NULL)) return -1;
+    int ret;
+    switch (op->type) {
+    case WL_INSERT:
+        ret = fprintf(trace, "i %lu %lu\n", op->id, op->arg);
+        break;
+    case WL_DELETE_MIN:
+        ret = fprintf(trace, "m\n");
+        break;
+    case WL_DELETE:
+        ret = fprintf(trace, "x %lu\n", op->id);
+        break;
+    case WL_DECREASE:
+    case WL_INCREASE:
+        ret = fprintf(trace, "%c %lu %lu\n",
+                      op->type == WL_DECREASE ? 'd' : 'u', op->id, op->arg);
+        break;
+    default:
+        return -1;
+    }
+    return ret < 0 ? -1 : 0;
+}
+
+/* Creates a heap to replay traces on, i.e. a pooled one with the ID index. */
+FibHeap *createWLHeap(void) {
+    FibHeap *newHeap = createPooledFibHeap(16);
+    if (newHeap == NULL) return NULL;
+    if (fhEnableIndex(newHeap, 0) != 0) {
+        eraseFibHeap(newHeap, 0);
+        return NULL;
+    }
+    return newHeap;
+}
+
+/* Applies an operation of a trace to a heap made by "createWLHeap".
+ * elem is the element of inserted nodes; hitElem (which can be NULL) is set
+ * to the element of the node hit by any other operation. Deleted nodes are
+ * erased.
+ * Returns 0 on success, -1 if the operation is invalid (e.g. an unknown ID,
+ * or a key change that would wrap around) or on failure.
+ */
+int wlApplyOp(FibHeap *heap, const WLOp *op, void *elem, void **hitElem) {
+    if ((heap == NULL) || (op == NULL)) return -1;
+    FibTreeNode *node = NULL;
+    switch (op->type) {
+    case WL_INSERT:
+        return fhInsertWithId(heap, elem, op->arg, op->id) != NULL ? 0 : -1;
+    case WL_DELETE_MIN:
+        node = fhDeleteMin(heap);
+        break;
+    case WL_DELETE:
+        node = fhDeleteById(heap, op->id);
+        break;
+    case WL_DECREASE:
+        node = fhFindById(heap, op->id);
+        if ((node == NULL) || (op->arg > node->key)) return -1;
+        fhDecreaseKey(heap, node, op->arg);
+        break;
+    case WL_INCREASE:
+        node = fhFindById(heap, op->id);
+        if ((node == NULL) || (op->arg > (UINT64_MAX - node->key))) return -1;
+        fhIncreaseKey(heap, node, op->arg);
+        break;
+    default:
+        return -1;
+    }
+    if (node == NULL) return -1;
+    if (hitElem != NULL) *hitElem = node->elem;
+    if ((op->type == WL_DELETE_MIN) || (op->type == WL_DELETE))
+        eraseFibTreeNode(node, 0);
+    return 0;
+}
+
+/* Fits a profile to a trace, which is read until its end.
+ * Returns a new profile, or NULL if the trace is malformed or invalid
+ * (lineNum, which can be NULL, then points to the offending line) or on
+ * failure.
+ */
+WLProfile *wlFitProfile(FILE *trace, ulong *lineNum) {
+    ulong localNum = 0;
+    if (lineNum == NULL) lineNum = &localNum;
+    *lineNum = 0;
+    if (trace == NULL) return NULL;
+    WLProfile *newProfile = calloc(1, sizeof(WLProfile));
+    FibHeap *heap = createWLHeap();
+    if ((newProfile == NULL) || (heap == NULL)) {
+        free(newProfile);
+        eraseFibHeap(heap, 0);
+        return NULL;
+    }
+
+    // Segments start as long as a single operation, and are merged in pairs
+    // each time they run out, so their number stays within a factor of two of
+    // the maximum whatever the length of the trace.
+    ulong segLen = 1;
+    uint64_t lastMin = 0;
+    WLOp op;
+    int ret;
+    while ((ret = wlReadOp(trace, &op, lineNum)) == 1) {
+        ulong time = newProfile->opsCount;
+        if (time == (segLen * WL_MAX_SEGMENTS)) {
+            _wlMergeSegments(newProfile);
+            segLen *= 2;
+        }
+        if (heap->min != NULL) lastMin = heap->min->key;
+        // Elements are insertion times, to get ages.
+        void *birth = NULL;
+        if (wlApplyOp(heap, &op, (void *)time, &birth) != 0) {
+            ret = -1;
+            break;
+        }
+        switch (op.type) {
+        case WL_INSERT:
+            if (op.arg >= lastMin)
+                (newProfile->keysAbove)[_wlBin(op.arg - lastMin)]++;
+            else (newProfile->keysBelow)[_wlBin(lastMin - op.arg)]++;
+            break;
+        case WL_DECREASE:
+            (newProfile->decs)[_wlBin(op.arg)]++;
+            break;
+        case WL_INCREASE:
+            (newProfile->incs)[_wlBin(op.arg)]++;
+            break;
+        }
+        if (op.type != WL_INSERT)
+            (newProfile->ages)[op.type][_wlBin(time - (ulong)birth)]++;
+        (newProfile->segOps)[time / segLen][op.type]++;
+        (newProfile->segSizes)[time / segLen] = heap->nodesCount;
+        newProfile->opsCount++;
+    }
+    eraseFibHeap(heap, 0);
+    if (ret != 0) {
+        free(newProfile);
+        return NULL;
+    }
+    newProfile->segmentsCount = (newProfile->opsCount + segLen - 1) / segLen;
+    return newProfile;
+}
+
+/* Saves a profile to a text file. Returns 0 on success, -1 on failure. */
+int wlSaveProfile(WLProfile *profile, FILE *file) {
+    if ((profile == NULL) || (file == NULL)) return -1;
+    if (fprintf(file, "wlprofile 1\nops %lu\nsegments %lu\n",
+                profile->opsCount, profile->segmentsCount) < 0) return -1;
+    for (ulong i = 0; i < profile->segmentsCount; i++) {
+        ulong *ops = (profile->segOps)[i];
+        if (fprintf(file, "seg %lu %lu %lu %lu %lu %lu\n", ops[WL_INSERT],
+                    ops[WL_DELETE_MIN], ops[WL_DELETE], ops[WL_DECREASE],
+                    ops[WL_INCREASE], (profile->segSizes)[i]) < 0) return -1;
+    }
+    if (_wlSaveHist(file, "keysabove", profile->keysAbove) ||
+        _wlSaveHist(file, "keysbelow", profile->keysBelow) ||
+        _wlSaveHist(file, "decs", profile->decs) ||
+        _wlSaveHist(file, "incs", profile->incs)) return -1;
+    for (int i = WL_DELETE_MIN; i < WL_OP_TYPES; i++)
+        if (_wlSaveHist(file, _wlOpNames[i], (profile->ages)[i])) return -1;
+    return 0;
+}
+
+/* Loads a profile from a text file, as written by "wlSaveProfile".
+ * Returns a new profile, or NULL if the file is malformed or on failure.
+ */
+WLProfile *wlLoadProfile(FILE *file) {
+    if (file == NULL) return NULL;
+    WLProfile *newProfile = calloc(1, sizeof(WLProfile));
+    if (newProfile == NULL) return NULL;
+    int version = 0, ok;
+    ok = (fscanf(file, " wlprofile %d ops %lu segments %lu", &version,
+                 &(newProfile->opsCount), &(newProfile->segmentsCount)) == 3) &&
+         (version == 1) && (newProfile->segmentsCount <= WL_MAX_SEGMENTS);
+    ulong opsSum = 0;
+    for (ulong i = 0; ok && (i < newProfile->segmentsCount); i++) {
+        ulong *ops = (newProfile->segOps)[i];
+        ok = fscanf(file, " seg %lu %lu %lu %lu %lu %lu", &(ops[WL_INSERT]),
+                    &(ops[WL_DELETE_MIN]), &(ops[WL_DELETE]),
+                    &(ops[WL_DECREASE]), &(ops[WL_INCREASE]),
+                    &((newProfile->segSizes)[i])) == 6;
+        for (int j = 0; j < WL_OP_TYPES; j++) opsSum += ops[j];
+    }
+    ok = ok && (opsSum == newProfile->opsCount) &&
+         !_wlLoadHist(file, "keysabove", newProfile->keysAbove) &&
+         !_wlLoadHist(file, "keysbelow", newProfile->keysBelow) &&
+         !_wlLoadHist(file, "decs", newProfile->decs) &&
+         !_wlLoadHist(file, "incs", newProfile->incs);
+    for (int i = WL_DELETE_MIN; ok && (i < WL_OP_TYPES); i++)
+        ok = !_wlLoadHist(file, _wlOpNames[i], (newProfile->ages)[i]);
+    if (!ok) {
+        free(newProfile);
+        return NULL;
+    }
+    return newProfile;
+}
+
+/* Returns an upper bound of the q-quantile (q in [0, 1]) of the values in a
+ * histogram, i.e. the upper end of the bin that holds it (0 if empty).
+ */
+uint64_t wlHistQuantile(const ulong *hist, double q) {
+    if (hist == NULL) return 0;
+    ulong total = 0;
+    for (int i = 0; i < WL_HIST_BINS; i++) total += hist[i];
+    if (total == 0) return 0;
+    ulong rank = (ulong)(q * (double)total);
+    if (rank >= total) rank = total - 1;
+    ulong seen = 0;
+    int bin = 0;
+    while ((seen += hist[bin]) <= rank) bin++;
+    if (bin == 0) return 0;
+    return bin == 64 ? UINT64_MAX : (1ULL << bin) - 1;
+}
+
+/* Creates a generator of a synthetic trace of opsCount operations, following
+ * a profile (which must outlive the generator). The same seed gives the same
+ * trace.
+ */
+WLGenerator *createWLGenerator(WLProfile *profile, ulong opsCount,
+                               uint64_t seed) {
+    if ((profile == NULL) || (profile->opsCount == 0) ||
+        (profile->segmentsCount == 0) || (opsCount == 0)) return NULL;
+    WLGenerator *newGen = calloc(1, sizeof(WLGenerator));
+    if (newGen == NULL) return NULL;
+    newGen->_heap = createPooledFibHeap(16);
+    newGen->_liveCap = 1024;
+    newGen->_live = calloc(newGen->_liveCap, sizeof(FibHandle));
+    newGen->_births = calloc(newGen->_liveCap, sizeof(ulong));
+    if ((newGen->_heap == NULL) || (newGen->_live == NULL) ||
+        (newGen->_births == NULL)) {
+        eraseWLGenerator(newGen);
+        return NULL;
+    }
+    newGen->_profile = profile;
+    newGen->opsCount = opsCount;
+    newGen->_rng = seed != 0 ? seed : 0x9E3779B97F4A7C15ULL;
+    newGen->_segEnd = _wlSegmentEnd(newGen, 0);
+    return newGen;
+}
+
+/* Deletes a generator, freeing memory. */
+void eraseWLGenerator(WLGenerator *gen) {
+    if (gen == NULL) return;
+    eraseFibHeap(gen->_heap, 0);
+    free(gen->_live);
+    free(gen->_births);
+    free(gen);
+}
+
+/* Generates the next operation of a synthetic trace.
+ * Returns 1 if an operation was generated, 0 at the end of the trace, -1 on
+ * failure.
+ */
+int wlNextOp(WLGenerator *gen, WLOp *op) {
+    if ((gen == NULL) || (op == NULL)) return -1;
+    if (gen->time >= gen->opsCount) return 0;
+    WLProfile *profile = gen->_profile;
+    FibHeap *heap = gen->_heap;
+    while ((gen->time >= gen->_segEnd) &&
+           ((gen->_segment + 1) < profile->segmentsCount)) {
+        gen->_segment++;
+        gen->_segEnd = _wlSegmentEnd(gen, gen->_segment);
+    }
+
+    // Draw the operation from the mix of the segment: anything but an
+    // insertion needs a live element, though.
+    ulong *mix = (profile->segOps)[gen->_segment];
+    ulong total = 0;
+    for (int i = 0; i < WL_OP_TYPES; i++) total += mix[i];
+    ulong draw = total > 0 ? _wlRandom(&(gen->_rng)) % total : 0;
+    int type = WL_INSERT;
+    while ((type < (WL_OP_TYPES - 1)) && (draw >= mix[type]))
+        draw -= mix[type++];
+    if (heap->nodesCount == 0) type = WL_INSERT;
+    if (heap->min != NULL) gen->_lastMin = heap->min->key;
+    op->type = type;
+    op->id = 0;
+    op->arg = 0;
+
+    FibTreeNode *node = NULL;
+    switch (type) {
+    case WL_INSERT: {
+        ulong above = 0, below = 0;
+        for (int i = 0; i < WL_HIST_BINS; i++) {
+            above += (profile->keysAbove)[i];
+            below += (profile->keysBelow)[i];
+        }
+        int isBelow = (below > 0) &&
+                      ((_wlRandom(&(gen->_rng)) % (above + below)) < below);
+        uint64_t offset = _wlDraw(gen, isBelow ? profile->keysBelow :
+                                                 profile->keysAbove);
+        if (isBelow) op->arg = offset < gen->_lastMin ?
+                               gen->_lastMin - offset : 0;
+        else op->arg = offset < (UINT64_MAX - gen->_lastMin) ?
+                       gen->_lastMin + offset : UINT64_MAX;
+        op->id = gen->_nextId++;
+        // Elements are IDs.
+        node = fhInsert(heap, (void *)(op->id), op->arg);
+        if ((node == NULL) || (_wlAddLive(gen, node) != 0)) return -1;
+        break;
+    }
+    case WL_DELETE_MIN:
+        eraseFibTreeNode(fhDeleteMin(heap), 0);
+        break;
+    default:
+        node = _wlPickTarget(gen, (profile->ages)[type]);
+        op->id = (uint64_t)(node->elem);
+        if (type == WL_DELETE) {
+            eraseFibTreeNode(fhDelete(heap, node), 0);
+        } else if (type == WL_DECREASE) {
+            op->arg = _wlDraw(gen, profile->decs);
+            if (op->arg > node->key) op->arg = node->key;
+            fhDecreaseKey(heap, node, op->arg);
+        } else {
+            op->arg = _wlDraw(gen, profile->incs);
+            if (op->arg > (UINT64_MAX - node->key))
+                op->arg = UINT64_MAX - node->key;
+            fhIncreaseKey(heap, node, op->arg);
+        }
+    }
+    // Drop dead elements once they are as many as the live ones.
+    if (gen->_liveCnt > ((2 * heap->nodesCount) + 1024)) _wlCompactLive(gen);
+    gen->time++;
+    return 1;
+}
+
+// INTERNAL LIBRARY SUBROUTINES //
+/* Parses an unsigned integer preceded by blanks, advancing the string.
+ * Returns 0 on success, -1 on failure.
+ */
+int _wlParseNum(char **str, uint64_t *num) {
+    char *curr = *str, *end;
+    while ((*curr == ' ') || (*curr == '\t')) curr++;
+    if ((*curr < '0') || (*curr > '9')) return -1;
+    *num = strtoull(curr, &end, 10);
+    if ((*end != '\0') && !isspace((unsigned char)*end)) return -1;
+    *str = end;
+    return 0;
+}
+
+/* Returns the histogram bin of a value. */
+ulong _wlBin(uint64_t value) {
+    return value == 0 ? 0 : 64 - (ulong)__builtin_clzll(value);
+}
+
+/* Merges the segments of a profile in pairs. */
+void _wlMergeSegments(WLProfile *profile) {
+    for (ulong i = 0; i < (WL_MAX_SEGMENTS / 2); i++) {
+        for (int j = 0; j < WL_OP_TYPES; j++)
+            (profile->segOps)[i][j] = (profile->segOps)[2 * i][j] +
+                                      (profile->segOps)[(2 * i) + 1][j];
+        (profile->segSizes)[i] = (profile->segSizes)[(2 * i) + 1];
+    }
+    memset((profile->segOps)[WL_MAX_SEGMENTS / 2], 0,
+           (WL_MAX_SEGMENTS / 2) * sizeof((profile->segOps)[0]));
+    memset(&((profile->segSizes)[WL_MAX_SEGMENTS / 2]), 0,
+           (WL_MAX_SEGMENTS / 2) * sizeof(ulong));
+}
+
+/* Writes a histogram to a profile file. Returns 0 on success, -1 on failure.
+ */
+int _wlSaveHist(FILE *file, const char *name, const ulong *hist) {
+    if (fprintf(file, "%s", name) < 0) return -1;
+    for (int i = 0; i < WL_HIST_BINS; i++)
+        if (fprintf(file, " %lu", hist[i]) < 0) return -1;
+    return fprintf(file, "\n") < 0 ? -1 : 0;
+}
+
+/* Reads a histogram from a profile file. Returns 0 on success, -1 on failure.
+ */
+int _wlLoadHist(FILE *file, const char *name, ulong *hist) {
+    char fileName[16];
+    if ((fscanf(file, " %15s", fileName) != 1) || strcmp(fileName, name))
+        return -1;
+    for (int i = 0; i < WL_HIST_BINS; i++)
+        if (fscanf(file, " %lu", &(hist[i])) != 1) return -1;
+    return 0;
+}
+
+/* Returns the time at which a segment ends in a generated trace, stretching
+ * the segments of the profile to its length.
+ */
+ulong _wlSegmentEnd(WLGenerator *gen, ulong segment) {
+    WLProfile *profile = gen->_profile;
+    ulong opsSum = 0;
+    for (ulong i = 0; i <= segment; i++)
+        for (int j = 0; j < WL_OP_TYPES; j++) opsSum += (profile->segOps)[i][j];
+    return (ulong)(((double)opsSum / (double)profile->opsCount) *
+                   (double)gen->opsCount);
+}
+
+/* Returns the next 64 pseudo-random bits (xorshift64*). */
+uint64_t _wlRandom(uint64_t *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+/* Draws a value from a histogram: a bin first, then a value in it. */
+uint64_t _wlDraw(WLGenerator *gen, const ulong *hist) {
+    ulong total = 0;
+    for (int i = 0; i < WL_HIST_BINS; i++) total += hist[i];
+    if (total == 0) return 0;
+    ulong draw = _wlRandom(&(gen->_rng)) % total;
+    int bin = 0;
+    while (draw >= hist[bin]) draw -= hist[bin++];
+    if (bin == 0) return 0;
+    uint64_t low = 1ULL << (bin - 1);
+    return low + (_wlRandom(&(gen->_rng)) % low);
+}
+
+/* Appends a new element to the list of live ones.
+ * Returns 0 on success, -1 on failure.
+ */
+int _wlAddLive(WLGenerator *gen, FibTreeNode *node) {
+    if (gen->_liveCnt == gen->_liveCap) {
+        ulong newCap = gen->_liveCap * 2;
+        FibHandle *newLive = reallocarray(gen->_live, newCap,
+                                          sizeof(FibHandle));
+        if (newLive == NULL) return -1;
+        gen->_live = newLive;
+        ulong *newBirths = reallocarray(gen->_births, newCap, sizeof(ulong));
+        if (newBirths == NULL) return -1;
+        gen->_births = newBirths;
+        gen->_liveCap = newCap;
+    }
+    (gen->_live)[gen->_liveCnt] = fhHandle(node);
+    (gen->_births)[gen->_liveCnt] = gen->time;
+    gen->_liveCnt++;
+    return 0;
+}
+
+/* Removes dead elements from the list of live ones, keeping it in order. */
+void _wlCompactLive(WLGenerator *gen) {
+    ulong cnt = 0;
+    for (ulong i = 0; i < gen->_liveCnt; i++) {
+        if (fhResolve(gen->_heap, (gen->_live)[i]) == NULL) continue;
+        (gen->_live)[cnt] = (gen->_live)[i];
+        (gen->_births)[cnt] = (gen->_births)[i];
+        cnt++;
+    }
+    gen->_liveCnt = cnt;
+}
+
+/* Picks a live element with an age drawn from a histogram: the youngest one
+ * that is at least that old, or the oldest one if there is none.
+ * The heap must not be empty.
+ */
+FibTreeNode *_wlPickTarget(WLGenerator *gen, const ulong *ages) {
+    ulong age = _wlDraw(gen, ages);
+    ulong birth = age < gen->time ? gen->time - age : 0;
+    // Find the last element born not after that time.
+    ulong low = 0, high = gen->_liveCnt;
+    while (low < high) {
+        ulong mid = low + ((high - low) / 2);
+        if ((gen->_births)[mid] <= birth) low = mid + 1;
+        else high = mid;
+    }
+    FibTreeNode *node = NULL;
+    ulong skipped = 0;
+    for (ulong i = low; (node == NULL) && (i-- > 0); skipped++)
+        node = fhResolve(gen->_heap, (gen->_live)[i]);
+    for (ulong i = low; (node == NULL) && (i < gen->_liveCnt); i++, skipped++)
+        node = fhResolve(gen->_heap, (gen->_live)[i]);
+    // Long runs of dead elements are dropped, so that picks take
+    // O(sqrt(n)) amortized time.
+    if ((skipped * skipped) > gen->_liveCnt) _wlCompactLive(gen);
+    return node;  // Not NULL if the heap is not empty.
+}
@@ -0,0 +1,111 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * This file contains type definitions and declarations for the Workload
+ * library, which describes heap workloads by statistical profiles, so that
+ * traces recorded where they can't be shared can be replaced by synthetic
+ * ones, of any length, for benchmarks.
+ * Traces are text files with an operation per line, on elements identified
+ * by unsigned 64-bit IDs chosen by the recorder:
+ * - "i <id> <key>": insertion of an element with a key;
+ * - "m": deletion of the minimum;
+ * - "x <id>": deletion of an element;
+ * - "d <id> <dec>": decrease of the key of an element of dec;
+ * - "u <id> <inc>": increase of the key of an element of inc.
+ * Empty lines and lines starting with '#' are ignored.
+ * A profile is fitted from a trace by replaying it on a Fibonacci Heap, and
+ * holds:
+ * - the operation mix and the heap size along the trace, in segments of
+ *   equal length;
+ * - the distributions of the keys of insertions (relative to the minimum key
+ *   at that time) and of the amounts of key changes;
+ * - the distributions of the ages of the elements hit by each operation, in
+ *   operations since their insertion, i.e. their lifetimes for deletions.
+ * Distributions are histograms with a bin for each power of two.
+ * The generator follows the operation mix of each segment, stretched to the
+ * requested length, and draws keys, amounts and target elements from the
+ * distributions. Synthetic traces longer than the original one also grow
+ * heaps that are larger by the same factor.
+ * The "tracegen" program fits, generates and shows profiles.
+ * NOTE: Profiles are saved as text files, to be inspected before they leave
+ * the machine of the recorded trace: they hold no keys or IDs, only counts.
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "../FibonacciHeap_uint64-keys/FibonacciHeap_uint64-keys.h"
+
+/* Operation types. */
+#define WL_INSERT 0
+#define WL_DELETE_MIN 1
+#define WL_DELETE 2
+#define WL_DECREASE 3
+#define WL_INCREASE 4
+#define WL_OP_TYPES 5
+
+/* Maximum number of segments of a profile, and bins of its histograms
+ * (bin 0 counts zeros, bin b values in [2^(b - 1), 2^b)).
+ */
+#define WL_MAX_SEGMENTS 128
+#define WL_HIST_BINS 65
+
+/* Heap operation, as read from or written to a trace. */
+typedef struct {
+    int type;
+    uint64_t id;            // Unused by minimum deletions.
+    uint64_t arg;           // Key, or key delta.
+} WLOp;
+
+/* Workload profile. */
+typedef struct {
+    ulong opsCount;                              // Length of the trace.
+    ulong segmentsCount;
+    ulong segOps[WL_MAX_SEGMENTS][WL_OP_TYPES];  // Operations by type.
+    ulong segSizes[WL_MAX_SEGMENTS];             // Heap size at the end.
+    ulong keysAbove[WL_HIST_BINS];   // Inserted keys minus the minimum.
+    ulong keysBelow[WL_HIST_BINS];   // Minimum minus inserted keys below it.
+    ulong decs[WL_HIST_BINS];        // Key decrease amounts.
+    ulong incs[WL_HIST_BINS];        // Key increase amounts.
+    ulong ages[WL_OP_TYPES][WL_HIST_BINS];  // Ages of targets, by operation.
+} WLProfile;
+
+/* Synthetic trace generator. */
+typedef struct {
+    WLProfile *_profile;
+    FibHeap *_heap;         // Pooled heap of the live elements.
+    FibHandle *_live;       // Elements by insertion, some no longer live.
+    ulong *_births;         // Insertion time of each of them.
+    ulong _liveCnt;
+    ulong _liveCap;
+    ulong _segment;         // Current segment.
+    ulong _segEnd;          // Time at which the current segment ends.
+    uint64_t _lastMin;      // Last minimum key seen.
+    uint64_t _nextId;
+    uint64_t _rng;
+    ulong opsCount;         // Operations to generate.
+    ulong time;             // Operations generated so far.
+} WLGenerator;
+
+/* Library functions. */
+int wlReadOp(FILE *trace, WLOp *op, ulong *lineNum);
+int wlWriteOp(FILE *trace, const WLOp *op);
+FibHeap *createWLHeap(void);
+int wlApplyOp(FibHeap *heap, const WLOp *op, void *elem, void **hitElem);
+WLProfile *wlFitProfile(FILE *trace, ulong *lineNum);
+int wlSaveProfile(WLProfile *profile, FILE *file);
+WLProfile *wlLoadProfile(FILE *file);
+uint64_t wlHistQuantile(const ulong *hist, double q);
+WLGenerator *createWLGenerator(WLProfile *profile, ulong opsCount,
+                               uint64_t seed);
+void eraseWLGenerator(WLGenerator *gen);
+int wlNextOp(WLGenerator *gen, WLOp *op);
+
+#endif
@@ -0,0 +1,148 @@
+/* Roberto Masocco
+ * 18/10/2026
+ * -----------------------------------------------------------------------------
+ * Fits workload profiles to heap traces, and generates synthetic traces from
+ * them (see the Workload library for both formats). Commands:
+ * - fit: reads a trace and writes its profile;
+ * - gen: writes a synthetic trace of a given number of operations, following
+ *   a profile, with a pseudo-random seed (default: 42);
+ * - show: prints a summary of a profile, e.g. to compare that of a recorded
+ *   trace with that fitted again to a synthetic one.
+ * "-" stands for the standard input or output.
+ * Usage: tracegen fit <trace> <profile>
+ *        tracegen gen <profile> <operations> <trace> [seed]
+ *        tracegen show <profile>
+ */
+/* This code is released under the MIT license.
+ * See the attached LICENSE file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Workload.h"
+
+/* Opens a file, or returns a standard stream for "-", exiting on failure. */
+FILE *openFile(const char *path, const char *mode) {
+    if (!strcmp(path, "-")) return mode[0] == 'r' ? stdin : stdout;
+    FILE *file = fopen(path, mode);
+    if (file == NULL) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+/* Closes a file opened by "openFile", exiting on failure. */
+void closeFile(FILE *file, const char *path) {
+    if (fclose(file) != 0) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Loads a profile, exiting on failure. */
+WLProfile *loadProfile(const char *path) {
+    FILE *file = openFile(path, "r");
+    WLProfile *profile = wlLoadProfile(file);
+    if (profile == NULL) {
+        fprintf(stderr, "%s: bad profile.\n", path);
+        exit(EXIT_FAILURE);
+    }
+    closeFile(file, path);
+    return profile;
+}
+
+/* Prints quantiles of a histogram. */
+void showHist(const char *name, const ulong *hist) {
+    ulong total = 0;
+    for (int i = 0; i < WL_HIST_BINS; i++) total += hist[i];
+    printf("  %-22s %12lu  p50 <= %-10lu p90 <= %-10lu p99 <= %-10lu "
+           "max <= %lu\n", name, total, wlHistQuantile(hist, 0.5),
+           wlHistQuantile(hist, 0.9), wlHistQuantile(hist, 0.99),
+           wlHistQuantile(hist, 1.0));
+}
+
+/* Prints a summary of a profile. */
+void showProfile(WLProfile *profile) {
+    static const char *names[WL_OP_TYPES] = {"insert", "delete-min", "delete",
+                                             "decrease", "increase"};
+    ulong totals[WL_OP_TYPES] = {0};
+    for (ulong i = 0; i < profile->segmentsCount; i++)
+        for (int j = 0; j < WL_OP_TYPES; j++)
+            totals[j] += (profile->segOps)[i][j];
+    printf("%lu operations in %lu segments\nmix:\n", profile->opsCount,
+           profile->segmentsCount);
+    for (int j = 0; j < WL_OP_TYPES; j++)
+        printf("  %-10s %12lu  %6.2f%%\n", names[j], totals[j],
+               100.0 * (double)totals[j] / (double)profile->opsCount);
+    printf("heap size at 1/8ths of the trace:\n ");
+    for (ulong i = 1; (i <= 8) && (profile->segmentsCount > 0); i++)
+        printf(" %lu", (profile->segSizes)[(((i * profile->segmentsCount) +
+                                             7) / 8) - 1]);
+    printf("\nkeys and key changes:\n");
+    showHist("inserted above min", profile->keysAbove);
+    showHist("inserted below min", profile->keysBelow);
+    showHist("decrease amounts", profile->decs);
+    showHist("increase amounts", profile->incs);
+    printf("ages of targets (operations since insertion):\n");
+    for (int j = WL_DELETE_MIN; j < WL_OP_TYPES; j++)
+        showHist(names[j], (profile->ages)[j]);
+}
+
+int main(int argc, char **argv) {
+    if ((argc == 4) && !strcmp(argv[1], "fit")) {
+        FILE *trace = openFile(argv[2], "r");
+        ulong lineNum;
+        WLProfile *profile = wlFitProfile(trace, &lineNum);
+        if (profile == NULL) {
+            fprintf(stderr, "%s:%lu: bad or invalid operation.\n", argv[2],
+                    lineNum);
+            exit(EXIT_FAILURE);
+        }
+        closeFile(trace, argv[2]);
+        FILE *out = openFile(argv[3], "w");
+        if (wlSaveProfile(profile, out) != 0) {
+            perror(argv[3]);
+            exit(EXIT_FAILURE);
+        }
+        closeFile(out, argv[3]);
+        free(profile);
+    } else if (((argc == 5) || (argc == 6)) && !strcmp(argv[1], "gen")) {
+        WLProfile *profile = loadProfile(argv[2]);
+        ulong opsCount = strtoul(argv[3], NULL, 10);
+        uint64_t seed = argc == 6 ? strtoull(argv[5], NULL, 10) : 42;
+        WLGenerator *gen = createWLGenerator(profile, opsCount, seed);
+        if (gen == NULL) {
+            fprintf(stderr, "Empty profile or trace, or out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+        FILE *out = openFile(argv[4], "w");
+        WLOp op;
+        int ret;
+        while ((ret = wlNextOp(gen, &op)) == 1) {
+            if (wlWriteOp(out, &op) != 0) {
+                perror(argv[4]);
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (ret != 0) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(EXIT_FAILURE);
+        }
+        closeFile(out, argv[4]);
+        eraseWLGenerator(gen);
+        free(profile);
+    } else if ((argc == 3) && !strcmp(argv[1], "show")) {
+        WLProfile *profile = loadProfile(argv[2]);
+        showProfile(profile);
+        free(profile);
+    } else {
+        fprintf(stderr, "Usage: %s fit <trace> <profile>\n"
+                "       %s gen <profile> <operations> <trace> [seed]\n"
+                "       %s show <profile>\n", argv[0], argv[0], argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    exit(EXIT_SUCCESS);
+}